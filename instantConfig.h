@@ -22,15 +22,42 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#ifndef INSTANTCONFIG_H
+#define INSTANTCONFIG_H
+
 #include <cstdint>
 #include <cstddef>
 #include <iostream>
 #include <utility>
 #include <vector>
+#include <array>
 #include <tuple>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <regex>
 #include <functional>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <future>
+#include <memory>
+#include <exception>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <cstring>
+#include <stdexcept>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+#if __cplusplus >= 202002L
+#include <coroutine>
+#endif
 
 /*****************************************************
     optional
@@ -48,6 +75,18 @@ namespace icfg{
 
   class ConfigError;
   class LengthError;
+  
+  template <std::size_t N>
+  class inline_string;
+  
+  template <typename T>
+  class hash_set;
+  
+  template <typename T>
+  class flat_map;
+  
+  template <typename T>
+  class frozen_map;
     
   namespace internal{
   
@@ -128,6 +167,13 @@ namespace icfg{
     template <typename LoaderT>
     struct ConfigValueLoader_t;
 
+    struct ConfigValueValidator_t;
+
+    struct LoadContext;
+
+    template <typename ResultT, typename DefinitionT>
+    std::vector<ConfigError> ValidateBoundResult(const ResultT& result, const DefinitionT& definition, const LoadContext& context);
+
     template <typename needle, typename... values>
     struct ExtractSettingFromName;
 
@@ -270,186 +316,1695 @@ namespace icfg{
     Error classes
 ******************************************************/
 
+  //category of a ConfigError, to sort errors without formatting their message
+  enum class error_code{
+    custom,
+    missing_setting,
+    length_constraint,
+    range_constraint,
+    choice_constraint,
+    pattern_constraint,
+    uniqueness_constraint,
+    order_constraint,
+    check_constraint
+  };
+  
+  namespace internal{
+  
+    //argument of an error message, kept as is until the message is asked for
+    class ErrorArgument{
+    
+    public:
+      enum Kind{
+        Signed,
+        Unsigned,
+        Floating,
+        //string literal
+        Literal,
+        //slice of the error's own text
+        Text,
+        //the error's shared text
+        SharedText,
+        //static name getter, as settingName<>::getString
+        Name
+      };
+      
+      ErrorArgument()
+      : mKind(Signed){
+        mValue.integer = 0;
+      }
+      
+      template <typename T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, int>::type = 0>
+      ErrorArgument(T value)
+      : mKind(Signed){
+        mValue.integer = value;
+      }
+      
+      template <typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value, int>::type = 0>
+      ErrorArgument(T value)
+      : mKind(Unsigned){
+        mValue.unsignedInteger = value;
+      }
+      
+      template <typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+      ErrorArgument(T value)
+      : mKind(Floating){
+        mValue.floating = value;
+      }
+      
+      ErrorArgument(const char* literal)
+      : mKind(Literal){
+        mValue.literal = literal;
+      }
+      
+      ErrorArgument(std::string (*name)())
+      : mKind(Name){
+        mValue.name = name;
+      }
+      
+      static ErrorArgument text(std::size_t offset, std::size_t length){
+        ErrorArgument argument;
+        argument.mKind = Text;
+        argument.mValue.slice.offset = static_cast<uint32_t>(offset);
+        argument.mValue.slice.length = static_cast<uint32_t>(length);
+        return argument;
+      }
+      
+      static ErrorArgument sharedText(){
+        ErrorArgument argument;
+        argument.mKind = SharedText;
+        return argument;
+      }
+      
+      //strings are quoted, as values of the configuration
+      std::string format(const std::string& text, const std::string* sharedText) const {
+        switch (mKind){
+          case Signed:     return std::to_string(mValue.integer);
+          case Unsigned:   return std::to_string(mValue.unsignedInteger);
+          case Floating:   return std::to_string(mValue.floating);
+          case Literal:    return mValue.literal;
+          case Text:       return "\"" + text.substr(mValue.slice.offset, mValue.slice.length) + "\"";
+          case SharedText: return sharedText != nullptr ? *sharedText : std::string();
+          case Name:       return mValue.name();
+        }
+        return std::string();
+      }
+      
+    private:
+      Kind mKind;
+      union{
+        long long integer;
+        unsigned long long unsignedInteger;
+        double floating;
+        const char* literal;
+        std::string (*name)();
+        struct{
+          uint32_t offset;
+          uint32_t length;
+        } slice;
+      } mValue;
+    };
+    
+  }
+  
+  /*
+    Error reported by a load : a code and a few arguments, the message
+    being only formatted when what() is called. Text, path and location
+    lie in a block of their own, allocated once one of them is set
+  */
   class ConfigError{
 
   public:
+    static const std::size_t sMaxArguments = 4;
+    
     ConfigError(const std::string& pWhat)
-    : mWhat(pWhat){}
+    : mCode(error_code::custom)
+    , mArgumentCount(0)
+    , mDetails(new Details()){
+      mDetails->text = pWhat;
+    }
+    
+    explicit ConfigError(error_code pCode)
+    : mCode(pCode)
+    , mArgumentCount(0)
+    , mDetails(){}
+    
+    ConfigError(const ConfigError& other)
+    : mCode(other.mCode)
+    , mArgumentCount(other.mArgumentCount)
+    , mDetails(other.mDetails ? new Details(*other.mDetails) : nullptr){
+      std::copy(other.mArguments, other.mArguments + other.mArgumentCount, mArguments);
+    }
+    
+    ConfigError(ConfigError&&) = default;
+    
+    ConfigError& operator=(const ConfigError& other){
+      if (this != &other){
+        mCode = other.mCode;
+        mArgumentCount = other.mArgumentCount;
+        std::copy(other.mArguments, other.mArguments + other.mArgumentCount, mArguments);
+        mDetails.reset(other.mDetails ? new Details(*other.mDetails) : nullptr);
+      }
+      return *this;
+    }
+    
+    ConfigError& operator=(ConfigError&&) = default;
     
     virtual ~ConfigError(){}
     
+    error_code code() const {
+      return mCode;
+    }
+    
+    //arguments of the message, in the order its format expects them
+    ConfigError& with(const internal::ErrorArgument& argument){
+      if (mArgumentCount < sMaxArguments){
+        mArguments[mArgumentCount++] = argument;
+      }
+      return *this;
+    }
+    
+    ConfigError& with(const std::string& text){
+      std::string& ownText = details().text;
+      const std::size_t offset = ownText.size();
+      ownText += text;
+      return with(internal::ErrorArgument::text(offset, text.size()));
+    }
+    
+    template <std::size_t N>
+    ConfigError& with(const inline_string<N>& text){
+      std::string& ownText = details().text;
+      const std::size_t offset = ownText.size();
+      ownText.append(text.data(), text.size());
+      return with(internal::ErrorArgument::text(offset, text.size()));
+    }
+    
+    //text owned by the definition, e.g. the choices of a constraint, shared rather than copied
+    ConfigError& with(const std::shared_ptr<const std::string>& sharedText){
+      details().sharedText = sharedText;
+      return with(internal::ErrorArgument::sharedText());
+    }
+    
     virtual const std::string what() const {
-      return mWhat;
+      switch (mCode){
+        case error_code::custom:
+          return text();
+        case error_code::missing_setting:
+          return "The required setting "+(!mDetails || mDetails->path.empty() ? std::string() : mDetails->path.front())+" wasn't found in the configuration";
+        case error_code::length_constraint:
+          return "Length constraint failed : size must be "+argument(0)+" "+argument(1)+", actual is "+argument(2);
+        case error_code::range_constraint:
+          return mArgumentCount == 4 ?
+            "Range constraint failed : element "+argument(0)+" must be between "+argument(1)+" and "+argument(2)+", actual is "+argument(3) :
+            "Range constraint failed : value must be between "+argument(0)+" and "+argument(1)+", actual is "+argument(2);
+        case error_code::choice_constraint:
+          return mArgumentCount == 3 ?
+            "Choice constraint failed : element "+argument(0)+" must be one of "+argument(1)+", actual is "+argument(2) :
+            "Choice constraint failed : value must be one of "+argument(0)+", actual is "+argument(1);
+        case error_code::pattern_constraint:
+          return mArgumentCount == 3 ?
+            "Pattern constraint failed : element "+argument(0)+" must match "+argument(1)+", actual is "+argument(2) :
+            "Pattern constraint failed : value must match "+argument(0)+", actual is "+argument(1);
+        case error_code::uniqueness_constraint:
+          return "Uniqueness constraint failed : elements "+argument(0)+" and "+argument(1)+" are both "+argument(2);
+        case error_code::order_constraint:
+          return "Order constraint failed : element "+argument(0)+" is less than element "+argument(1)+", "+argument(2)+" < "+argument(3);
+        case error_code::check_constraint:
+          return "Constraint validation \""+argument(0)+"\" failed.";
+      }
+      return text();
     }
     
     void setFailingSettingName(const std::string& name){
-      mFailingSetting = name;
+      details().failingSetting = name;
     }
     
     const std::string& getFailingSettingName() const {
-      return mFailingSetting;
+      static const std::string none;
+      return mDetails ? mDetails->failingSetting : none;
+    }
+    
+    //dotted path of the setting at fault, from the root of the configuration
+    std::string getPath() const {
+      std::string path;
+      if (mDetails){
+        for (auto name = mDetails->path.rbegin(); name != mDetails->path.rend(); ++name){
+          if (name != mDetails->path.rbegin()){
+            path.push_back('.');
+          }
+          path += *name;
+        }
+      }
+      return path;
+    }
+    
+    std::vector<std::string> getPathNames() const {
+      return mDetails ? std::vector<std::string>(mDetails->path.rbegin(), mDetails->path.rend()) : std::vector<std::string>();
+    }
+    
+    //called while unwinding, from the setting at fault up to the root ; an error
+    //with a path allocates its details block like one with a text or a location
+    void prefixPath(const std::string& name){
+      details().path.push_back(name);
+    }
+    
+    //where the setting lies, as found by the loader once the error is reported ;
+    //line and column start at 1, and are 0 when the loader can't tell
+    const std::string& getFile() const {
+      static const std::string unknown;
+      return mDetails && mDetails->file ? *mDetails->file : unknown;
+    }
+    
+    std::size_t getLine() const {
+      return mDetails ? mDetails->line : 0;
+    }
+    
+    std::size_t getColumn() const {
+      return mDetails ? mDetails->column : 0;
+    }
+    
+    //the file name is shared by the errors of a load
+    void setLocation(const std::shared_ptr<const std::string>& file, std::size_t line, std::size_t column){
+      Details& own = details();
+      own.file = file;
+      own.line = line;
+      own.column = column;
     }
     
   private:
-    std::string mWhat;
-    std::string mFailingSetting;
+    struct Details{
+      Details()
+      : line(0)
+      , column(0){}
+      
+      //the message of a custom error, or the strings among the arguments
+      std::string text;
+      std::shared_ptr<const std::string> sharedText;
+      std::string failingSetting;
+      //from the setting at fault up to the root, the reverse of getPathNames()
+      std::vector<std::string> path;
+      std::shared_ptr<const std::string> file;
+      std::size_t line;
+      std::size_t column;
+    };
+    
+    Details& details(){
+      if (!mDetails){
+        mDetails.reset(new Details());
+      }
+      return *mDetails;
+    }
+    
+    std::string text() const {
+      return mDetails ? mDetails->text : std::string();
+    }
+    
+    std::string argument(std::size_t index) const {
+      static const std::string none;
+      if (index >= mArgumentCount){
+        return std::string();
+      }
+      return mArguments[index].format(mDetails ? mDetails->text : none, mDetails ? mDetails->sharedText.get() : nullptr);
+    }
+    
+    error_code mCode;
+    uint8_t mArgumentCount;
+    internal::ErrorArgument mArguments[sMaxArguments];
+    std::unique_ptr<Details> mDetails;
   };
 
 /*****************************************************
-    Setting parameters
+    ValuePath : location of a value inside the
+    configuration, as a chain of parent pointers.
+    Building one is free, it is only formatted into
+    a string when an error has to be reported.
 ******************************************************/
 
-  namespace internal{
-    struct stringTag{};// -> std::string
+  class ValuePath{
 
-    template<class T>
-    struct listTag{};//-> std::vector
+  public:
+    explicit ValuePath(const std::string& pName)
+    : mParent(nullptr)
+    , mName(&pName)
+    , mIndex(0){}
     
-    struct booleanTag {};
-    struct int8Tag {};
-    struct uint8Tag {};
-    struct int16Tag {};
-    struct uint16Tag {};
-    struct int32Tag {};
-    struct uint32Tag {};
-    struct int64Tag {};
-    struct uint64Tag {};
-    struct floatTag{};
-    struct doubleTag{};
+    ValuePath(const ValuePath& pParent, const std::string& pName)
+    : mParent(&pParent)
+    , mName(&pName)
+    , mIndex(0){}
     
-    struct optionalTag{};
+    ValuePath(const ValuePath& pParent, std::size_t pIndex)
+    : mParent(&pParent)
+    , mName(nullptr)
+    , mIndex(pIndex){}
     
-    struct requiredTag{};
+    std::string str() const {
+      std::string result;
+      append(result);
+      return result;
+    }
+    
+  private:
+    void append(std::string& pOut) const {
+      if (mParent){
+        mParent->append(pOut);
+      }
+      if (mName){
+        if (mParent){
+          pOut.push_back('.');
+        }
+        pOut += *mName;
+      } else {
+        pOut += "[" + std::to_string(mIndex) + "]";
+      }
+    }
+    
+    //the referenced names must outlive the path
+    const ValuePath* mParent;
+    const std::string* mName;
+    std::size_t mIndex;
+  };
 
+/*****************************************************
+    Loader inputs : documents that are not read from
+    a path, accepted by the loaders' constructors
+******************************************************/
 
-  }
-  static internal::stringTag string;
-  static internal::booleanTag boolean;
-  static internal::int8Tag int8;
-  static internal::uint8Tag uint8;
-  static internal::int16Tag int16;
-  static internal::uint16Tag uint16;
-  static internal::int32Tag int32;
-  static internal::uint32Tag uint32;
-  static internal::int64Tag int64;
-  static internal::uint64Tag uint64;
-  static internal::floatTag float32;
-  static internal::doubleTag float64;
+  //contiguous text owned by the caller, parsed where it lies : it must outlive the loader's constructor
+  class buffer_view{
 
-  template <typename T>
-  internal::listTag<T> list(T) {
-      return internal::listTag<T>();
-  }
+  public:
+    buffer_view(const char* pData, std::size_t pLength)
+    : mData(pData)
+    , mLength(pLength){}
+    
+    explicit buffer_view(const std::string& pContent)
+    : mData(pContent.data())
+    , mLength(pContent.size()){}
+    
+    const char* data() const {
+      return mData;
+    }
+    
+    std::size_t size() const {
+      return mLength;
+    }
+    
+  private:
+    const char* mData;
+    std::size_t mLength;
+  };
   
-  static internal::optionalTag optional;
-  static internal::requiredTag required;
+  //open file descriptor (file, memfd, pipe) read from its current offset ; it stays open, owned by the caller
+  class file_descriptor{
+
+  public:
+    explicit file_descriptor(int pDescriptor)
+    : mDescriptor(pDescriptor){}
+    
+    int get() const {
+      return mDescriptor;
+    }
+    
+    std::string name() const {
+      return "file descriptor " + std::to_string(mDescriptor);
+    }
     
+  private:
+    int mDescriptor;
+  };
+
 /*****************************************************
-    Constraints
+    Bulk list conversion : helpers for the loaders to
+    convert whole lists of numbers in one pass
 ******************************************************/
 
   namespace internal{
-    namespace LengthConstraint_internal{
-      namespace LengthConstraintType{
-        enum LengthConstraintType{
-          Equal,
-          LessOrEqual,
-          Less,
-          GreaterOrEqual,
-          Greater,
-          Different
-        };
-      }
-      
-      struct Equal{
-        static bool test(size_t ref, size_t actual){
-          return ref==actual;
-        }
-        static const internal::LengthConstraint_internal::LengthConstraintType::LengthConstraintType Type = internal::LengthConstraint_internal::LengthConstraintType::Equal;
-      };
-      struct GreaterEqual{
-        static bool test(size_t ref, size_t actual){
-          return actual>=ref;
-        }
-        static const internal::LengthConstraint_internal::LengthConstraintType::LengthConstraintType Type = internal::LengthConstraint_internal::LengthConstraintType::GreaterOrEqual;
-      };
-      struct Greater{
-        static bool test(size_t ref, size_t actual){
-          return actual>ref;
-        }
-        static const internal::LengthConstraint_internal::LengthConstraintType::LengthConstraintType Type = internal::LengthConstraint_internal::LengthConstraintType::Greater;
-      };
-      struct LessEqual{
-        static bool test(size_t ref, size_t actual){
-          return actual<=ref;
-        }
-        static const internal::LengthConstraint_internal::LengthConstraintType::LengthConstraintType Type = internal::LengthConstraint_internal::LengthConstraintType::LessOrEqual;
-      };
-      struct Less{
-        static bool test(size_t ref, size_t actual){
-          return actual<ref;
-        }
-        static const internal::LengthConstraint_internal::LengthConstraintType::LengthConstraintType Type = internal::LengthConstraint_internal::LengthConstraintType::Less;
-      };
-      struct Different{
-        static bool test(size_t ref, size_t actual){
-          return actual!=ref;
-        }
-        static const internal::LengthConstraint_internal::LengthConstraintType::LengthConstraintType Type = internal::LengthConstraint_internal::LengthConstraintType::Different;
-      };
-    }
-
-
-    template <typename ConstraintT>
-    struct LengthConstraint{
+  
+    struct genericElementsTag{};
+    struct integerElementsTag{};
+    struct floatingElementsTag{};
+    
+    //selects the list conversion path for a given element type
+    template <typename ValueT>
+    struct ElementsKind{
+      typedef typename std::conditional<std::is_integral<ValueT>::value && !std::is_same<ValueT, bool>::value, 
+                                        integerElementsTag,
+                                        typename std::conditional<std::is_floating_point<ValueT>::value, floatingElementsTag, genericElementsTag>::type
+                                       >::type type;
+    };
+    
+    //accumulates the bounds of a list of integers with branch-free min/max updates,
+    //so that the range of IntegerT is checked once for the whole list
+    template <typename IntegerT>
+    class IntegerBounds{
+    
+    public:
+      IntegerBounds()
+      : mMinSigned(0)
+      , mMaxSigned(0)
+      , mMaxUnsigned(0){}
       
-      size_t mRef;
+      void add(long long pValue){
+        mMinSigned = std::min(mMinSigned, pValue);
+        mMaxSigned = std::max(mMaxSigned, pValue);
+      }
       
-      bool validate(size_t pActual) const{
-        return ConstraintT::test(mRef, pActual);
+      void add(unsigned long long pValue){
+        mMaxUnsigned = std::max(mMaxUnsigned, pValue);
       }
       
-      ConfigError getError(size_t pActual) const{
-        std::string constraintDescription = ConstraintT::Type==internal::LengthConstraint_internal::LengthConstraintType::Equal?          "equal" :
-                                            ConstraintT::Type==internal::LengthConstraint_internal::LengthConstraintType::Different?      "different from" :
-                                            ConstraintT::Type==internal::LengthConstraint_internal::LengthConstraintType::Greater?        "greater than" :
-                                            ConstraintT::Type==internal::LengthConstraint_internal::LengthConstraintType::GreaterOrEqual? "greater or equal to" :
-                                            ConstraintT::Type==internal::LengthConstraint_internal::LengthConstraintType::Less?           "less than" :
-                                                                                                                                          "less or equal to";
-        return ConfigError("Length constraint failed : size must be "+constraintDescription+" "+std::to_string(mRef)+", actual is "+std::to_string(pActual));
+      bool fits() const {
+        return fitsSigned(std::is_signed<IntegerT>()) && mMaxUnsigned <= static_cast<unsigned long long>(std::numeric_limits<IntegerT>::max());
       }
       
-    };
-    struct lengthTag{
-      LengthConstraint<internal::LengthConstraint_internal::GreaterEqual> operator>=(std::size_t rhs){
-        return LengthConstraint<internal::LengthConstraint_internal::GreaterEqual>{rhs};
+    private:
+      bool fitsSigned(std::true_type) const {
+        return mMinSigned >= static_cast<long long>(std::numeric_limits<IntegerT>::min()) && mMaxSigned <= static_cast<long long>(std::numeric_limits<IntegerT>::max());
       }
       
-      LengthConstraint<internal::LengthConstraint_internal::Greater> operator>(std::size_t rhs){
-        return LengthConstraint<internal::LengthConstraint_internal::Greater>{rhs};
+      bool fitsSigned(std::false_type) const {
+        return mMinSigned >= 0 && static_cast<unsigned long long>(mMaxSigned) <= static_cast<unsigned long long>(std::numeric_limits<IntegerT>::max());
       }
       
-      LengthConstraint<internal::LengthConstraint_internal::LessEqual> operator<=(std::size_t rhs){
-        return LengthConstraint<internal::LengthConstraint_internal::LessEqual>{rhs};
+      long long mMinSigned;
+      long long mMaxSigned;
+      unsigned long long mMaxUnsigned;
+    };
+    
+  }
+
+/*****************************************************
+    inline_string : string of at most N characters,
+    stored in place, result of a fixed_string setting
+******************************************************/
+
+  namespace internal{
+  
+    //FNV-1a, for the hash of strings that aren't std::string
+    inline std::size_t HashBytes(const char* data, std::size_t length){
+      uint64_t hash = 14695981039346656037ULL;
+      for (std::size_t i = 0; i < length; ++i){
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+      }
+      return static_cast<std::size_t>(hash);
+    }
+    
+    //smallest integer type able to hold a size up to N
+    template <std::size_t N>
+    struct InlineSizeType{
+      typedef typename std::conditional<(N <= 0xff), uint8_t,
+              typename std::conditional<(N <= 0xffff), uint16_t, std::size_t>::type>::type type;
+    };
+    
+  }
+  
+  template <std::size_t N>
+  class inline_string{
+  
+  public:
+    typedef char value_type;
+    typedef std::size_t size_type;
+    typedef const char* const_iterator;
+    typedef const char* iterator;
+    
+    inline_string()
+    : mSize(0){
+      mData[0] = '\0';
+    }
+    
+    //throws std::length_error when the text is longer than N
+    inline_string(const char* text){
+      assignOrThrow(text, std::strlen(text));
+    }
+    
+    inline_string(const std::string& text){
+      assignOrThrow(text.data(), text.size());
+    }
+    
+    //false, and the string left unchanged, when the text is longer than N
+    bool assign(const char* data, std::size_t length){
+      if (length > N){
+        return false;
+      }
+      std::memcpy(mData, data, length);
+      mData[length] = '\0';
+      mSize = static_cast<size_type_t>(length);
+      return true;
+    }
+    
+    static constexpr std::size_t capacity(){
+      return N;
+    }
+    
+    std::size_t size() const {
+      return mSize;
+    }
+    
+    std::size_t length() const {
+      return mSize;
+    }
+    
+    bool empty() const {
+      return mSize == 0;
+    }
+    
+    const char* data() const {
+      return mData;
+    }
+    
+    const char* c_str() const {
+      return mData;
+    }
+    
+    const_iterator begin() const {
+      return mData;
+    }
+    
+    const_iterator end() const {
+      return mData + mSize;
+    }
+    
+    char operator[](std::size_t index) const {
+      return mData[index];
+    }
+    
+    std::string str() const {
+      return std::string(mData, mSize);
+    }
+    
+    int compare(const char* data, std::size_t length) const {
+      const int result = std::memcmp(mData, data, std::min<std::size_t>(mSize, length));
+      return result != 0 ? result : mSize < length ? -1 : mSize > length ? 1 : 0;
+    }
+    
+  private:
+    typedef typename internal::InlineSizeType<N>::type size_type_t;
+    
+    void assignOrThrow(const char* data, std::size_t length){
+      if (!assign(data, length)){
+        throw std::length_error("inline_string : text longer than its capacity");
+      }
+    }
+    
+    char mData[N + 1];
+    size_type_t mSize;
+  };
+  
+  template <std::size_t N, std::size_t M>
+  bool operator==(const inline_string<N>& lhs, const inline_string<M>& rhs){
+    return lhs.compare(rhs.data(), rhs.size()) == 0;
+  }
+  
+  template <std::size_t N>
+  bool operator==(const inline_string<N>& lhs, const std::string& rhs){
+    return lhs.compare(rhs.data(), rhs.size()) == 0;
+  }
+  
+  template <std::size_t N>
+  bool operator==(const std::string& lhs, const inline_string<N>& rhs){
+    return rhs == lhs;
+  }
+  
+  template <std::size_t N>
+  bool operator==(const inline_string<N>& lhs, const char* rhs){
+    return lhs.compare(rhs, std::strlen(rhs)) == 0;
+  }
+  
+  template <std::size_t N>
+  bool operator==(const char* lhs, const inline_string<N>& rhs){
+    return rhs == lhs;
+  }
+  
+  template <std::size_t N, typename T>
+  bool operator!=(const inline_string<N>& lhs, const T& rhs){
+    return !(lhs == rhs);
+  }
+  
+  template <std::size_t N>
+  bool operator!=(const std::string& lhs, const inline_string<N>& rhs){
+    return !(rhs == lhs);
+  }
+  
+  template <std::size_t N>
+  bool operator!=(const char* lhs, const inline_string<N>& rhs){
+    return !(rhs == lhs);
+  }
+  
+  template <std::size_t N, std::size_t M>
+  bool operator<(const inline_string<N>& lhs, const inline_string<M>& rhs){
+    return lhs.compare(rhs.data(), rhs.size()) < 0;
+  }
+  
+  template <std::size_t N>
+  std::ostream& operator<<(std::ostream& stream, const inline_string<N>& text){
+    return stream.write(text.data(), text.size());
+  }
+  
+}
+
+namespace std{
+
+  template <std::size_t N>
+  struct hash<icfg::inline_string<N>>{
+    std::size_t operator()(const icfg::inline_string<N>& text) const {
+      return icfg::internal::HashBytes(text.data(), text.size());
+    }
+  };
+  
+}
+
+namespace icfg{
+
+/*****************************************************
+    hash_set : open-addressing set, built once at
+    load, result of a set setting
+******************************************************/
+
+  namespace internal{
+  
+    //strings hash their bytes, so that a key given as characters finds its element
+    template <typename T>
+    std::size_t SetHash(const T& value){
+      return std::hash<T>()(value);
+    }
+    
+    inline std::size_t SetHash(const std::string& value){
+      return HashBytes(value.data(), value.size());
+    }
+    
+  }
+  
+  /*
+    The elements are kept contiguous, in the order of the configuration ;
+    the table only holds their index, at a load factor of at most 1/2
+  */
+  template <typename T>
+  class hash_set{
+  
+  public:
+    typedef T value_type;
+    typedef typename std::vector<T>::const_iterator const_iterator;
+    typedef const_iterator iterator;
+    
+    hash_set()
+    : mElements()
+    , mSlots()
+    , mShift(64){}
+    
+    void reserve(std::size_t count){
+      if (2 * count > mSlots.size()){
+        rehash(2 * count);
+      }
+    }
+    
+    //false, and the index of the equal element in existing, when the value is already there
+    bool insert(const T& value, std::size_t* existing = nullptr){
+      reserve(mElements.size() + 1);
+      std::size_t slot = findSlot(value, internal::SetHash(value));
+      if (mSlots[slot] != 0){
+        if (existing != nullptr){
+          *existing = mSlots[slot] - 1;
+        }
+        return false;
+      }
+      mElements.push_back(value);
+      mSlots[slot] = static_cast<uint32_t>(mElements.size());
+      return true;
+    }
+    
+    bool contains(const T& value) const {
+      return !mSlots.empty() && mSlots[findSlot(value, internal::SetHash(value))] != 0;
+    }
+    
+    //lookups of a set of strings without building a std::string
+    bool contains(const char* data, std::size_t length) const {
+      return !mSlots.empty() && mSlots[findSlot(CharRange{data, length}, internal::HashBytes(data, length))] != 0;
+    }
+    
+    bool contains(const char* text) const {
+      return contains(text, std::strlen(text));
+    }
+    
+#if __cplusplus >= 201703L
+    bool contains(std::string_view text) const {
+      return contains(text.data(), text.size());
+    }
+#endif
+    
+    template <typename KeyT>
+    std::size_t count(const KeyT& key) const {
+      return contains(key) ? 1 : 0;
+    }
+    
+    std::size_t size() const {
+      return mElements.size();
+    }
+    
+    bool empty() const {
+      return mElements.empty();
+    }
+    
+    const_iterator begin() const {
+      return mElements.begin();
+    }
+    
+    const_iterator end() const {
+      return mElements.end();
+    }
+    
+    //elements in the order of the configuration
+    const T& operator[](std::size_t index) const {
+      return mElements[index];
+    }
+    
+  private:
+    struct CharRange{
+      const char* data;
+      std::size_t length;
+    };
+    
+    static bool equal(const T& element, const T& value){
+      return element == value;
+    }
+    
+    static bool equal(const std::string& element, const CharRange& key){
+      return element.size() == key.length && std::memcmp(element.data(), key.data, key.length) == 0;
+    }
+    
+    //Fibonacci hashing : the high bits of the product pick the first slot, whatever the quality of std::hash
+    std::size_t firstSlot(std::size_t hash) const {
+      return static_cast<std::size_t>((static_cast<uint64_t>(hash) * 11400714819323198485ULL) >> mShift);
+    }
+    
+    //slot of the element equal to key, or the empty slot where it would go ; linear probing
+    template <typename KeyT>
+    std::size_t findSlot(const KeyT& key, std::size_t hash) const {
+      const std::size_t mask = mSlots.size() - 1;
+      for (std::size_t slot = firstSlot(hash); ; slot = (slot + 1) & mask){
+        if (mSlots[slot] == 0 || equal(mElements[mSlots[slot] - 1], key)){
+          return slot;
+        }
+      }
+    }
+    
+    void rehash(std::size_t minimum){
+      std::size_t slotCount = 2;
+      unsigned bits = 1;
+      while (slotCount < minimum){
+        slotCount *= 2;
+        ++bits;
+      }
+      mSlots.assign(slotCount, 0);
+      mShift = 64 - bits;
+      for (std::size_t i = 0; i < mElements.size(); ++i){
+        mSlots[findSlot(mElements[i], internal::SetHash(mElements[i]))] = static_cast<uint32_t>(i + 1);
+      }
+    }
+    
+    std::vector<T> mElements;
+    std::vector<uint32_t> mSlots;
+    unsigned mShift;
+  };
+
+/*****************************************************
+    flat_map and frozen_map : results of a map built
+    once at load, keyed by strings
+******************************************************/
+
+  namespace internal{
+  
+    //finalizer of MurmurHash3 : spreads a hash over all its bits
+    inline uint64_t MixHash(uint64_t hash){
+      hash ^= hash >> 33;
+      hash *= 0xff51afd7ed558ccdULL;
+      hash ^= hash >> 33;
+      hash *= 0xc4ceb9fe1a85ec53ULL;
+      hash ^= hash >> 33;
+      return hash;
+    }
+    
+    inline int CompareKeys(const std::string& key, const char* data, std::size_t length){
+      const int result = std::memcmp(key.data(), data, std::min(key.size(), length));
+      return result != 0 ? result : key.size() < length ? -1 : key.size() > length ? 1 : 0;
+    }
+    
+  }
+  
+  /*
+    Entries sorted by key in one vector, found by binary search. Keys may be
+    given as std::string or as characters, without building a std::string ;
+    lookups with operator[] and at() throw std::out_of_range on a missing key
+  */
+  template <typename T>
+  class flat_map{
+  
+  public:
+    typedef std::string key_type;
+    typedef T mapped_type;
+    typedef std::pair<std::string, T> value_type;
+    //read-only once loaded : a key changed in place would break the order lookups rely on
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+    typedef const_iterator iterator;
+    
+    flat_map()
+    : mEntries(){}
+    
+    const_iterator find(const char* data, std::size_t length) const {
+      const_iterator found = std::lower_bound(mEntries.begin(), mEntries.end(), length, [data](const value_type& entry, std::size_t keyLength){
+        return internal::CompareKeys(entry.first, data, keyLength) < 0;
+      });
+      return found != mEntries.end() && internal::CompareKeys(found->first, data, length) == 0 ? found : mEntries.end();
+    }
+    
+    const_iterator find(const char* key) const {
+      return find(key, std::strlen(key));
+    }
+    
+    const_iterator find(const std::string& key) const {
+      return find(key.data(), key.size());
+    }
+    
+#if __cplusplus >= 201703L
+    const_iterator find(std::string_view key) const {
+      return find(key.data(), key.size());
+    }
+#endif
+    
+    template <typename KeyT>
+    std::size_t count(const KeyT& key) const {
+      return find(key) != end() ? 1 : 0;
+    }
+    
+    template <typename KeyT>
+    const T& at(const KeyT& key) const {
+      const_iterator found = find(key);
+      if (found == end()){
+        throw std::out_of_range("no entry for this key in the map");
+      }
+      return found->second;
+    }
+    
+    template <typename KeyT>
+    const T& operator[](const KeyT& key) const {
+      return at(key);
+    }
+    
+    std::size_t size() const {
+      return mEntries.size();
+    }
+    
+    bool empty() const {
+      return mEntries.empty();
+    }
+    
+    const_iterator begin() const {
+      return mEntries.begin();
+    }
+    
+    const_iterator end() const {
+      return mEntries.end();
+    }
+    
+  private:
+    template <typename LoaderT>
+    friend struct internal::ConfigValueLoader_t;
+    
+    //filled by the loader only : entries appended in ascending key order, then sealed
+    void reserve(std::size_t count){
+      mEntries.reserve(count);
+    }
+    
+    T& append(std::string key){
+      mEntries.push_back(value_type(std::move(key), T()));
+      return mEntries.back().second;
+    }
+    
+    void seal(){}
+    
+  protected:
+    std::vector<value_type> mEntries;
+  };
+  
+  /*
+    flat_map with a perfect hash over its keys, built once at load :
+    a lookup hashes the key, reads the seed of its bucket, and compares
+    the one entry the seeded hash points to
+  */
+  template <typename T>
+  class frozen_map : public flat_map<T>{
+  
+  public:
+    typedef typename flat_map<T>::const_iterator const_iterator;
+    
+    frozen_map()
+    : flat_map<T>()
+    , mSeeds()
+    , mSlots(){}
+    
+    const_iterator find(const char* data, std::size_t length) const {
+      if (mSlots.empty()){
+        return flat_map<T>::find(data, length);
+      }
+      const uint64_t hash = internal::HashBytes(data, length);
+      const uint32_t entry = mSlots[slotOf(hash, mSeeds[bucketOf(hash)])];
+      return entry != 0 && internal::CompareKeys(this->mEntries[entry - 1].first, data, length) == 0 ? this->begin() + (entry - 1) : this->end();
+    }
+    
+    const_iterator find(const char* key) const {
+      return find(key, std::strlen(key));
+    }
+    
+    const_iterator find(const std::string& key) const {
+      return find(key.data(), key.size());
+    }
+    
+#if __cplusplus >= 201703L
+    const_iterator find(std::string_view key) const {
+      return find(key.data(), key.size());
+    }
+#endif
+    
+    template <typename KeyT>
+    std::size_t count(const KeyT& key) const {
+      return find(key) != this->end() ? 1 : 0;
+    }
+    
+    template <typename KeyT>
+    const T& at(const KeyT& key) const {
+      const_iterator found = find(key);
+      if (found == this->end()){
+        throw std::out_of_range("no entry for this key in the map");
+      }
+      return found->second;
+    }
+    
+    template <typename KeyT>
+    const T& operator[](const KeyT& key) const {
+      return at(key);
+    }
+    
+  private:
+    template <typename LoaderT>
+    friend struct internal::ConfigValueLoader_t;
+    
+    /*
+      Hash and displace : buckets are placed from the largest, each with the
+      first seed sending all its keys to free slots. The table starts with
+      a quarter of spare slots, and grows when a bucket finds no seed. Keys
+      whose hashes are equal never separate : after a few growths, lookups
+      fall back to the binary search of flat_map
+    */
+    void seal(){
+      const std::size_t count = this->mEntries.size();
+      mSeeds.clear();
+      mSlots.clear();
+      if (count == 0){
+        return;
+      }
+      
+      std::vector<uint64_t> hashes(count);
+      for (std::size_t i = 0; i < count; ++i){
+        hashes[i] = internal::HashBytes(this->mEntries[i].first.data(), this->mEntries[i].first.size());
+      }
+      
+      std::size_t slotCount = count + count / 4 + 1;
+      for (unsigned growth = 0; growth < sMaxGrowths; ++growth, slotCount += slotCount / 2 + 1){
+        if (place(hashes, count / 4 + 1, slotCount)){
+          return;
+        }
+      }
+      mSeeds.clear();
+      mSlots.clear();
+    }
+    
+    static const uint32_t sMaxSeed = 1u << 16;
+    static const unsigned sMaxGrowths = 8;
+    
+    std::size_t bucketOf(uint64_t hash) const {
+      return static_cast<std::size_t>(internal::MixHash(hash) % mSeeds.size());
+    }
+    
+    std::size_t slotOf(uint64_t hash, uint32_t seed) const {
+      return static_cast<std::size_t>(internal::MixHash(hash ^ (seed * 0x9e3779b97f4a7c15ULL)) % mSlots.size());
+    }
+    
+    bool place(const std::vector<uint64_t>& hashes, std::size_t bucketCount, std::size_t slotCount){
+      mSeeds.assign(bucketCount, 0);
+      mSlots.assign(slotCount, 0);
+      
+      std::vector<std::vector<uint32_t>> buckets(bucketCount);
+      for (std::size_t i = 0; i < hashes.size(); ++i){
+        buckets[bucketOf(hashes[i])].push_back(static_cast<uint32_t>(i));
+      }
+      std::vector<std::size_t> order(bucketCount);
+      for (std::size_t b = 0; b < bucketCount; ++b){
+        order[b] = b;
+      }
+      std::stable_sort(order.begin(), order.end(), [&buckets](std::size_t lhs, std::size_t rhs){
+        return buckets[lhs].size() > buckets[rhs].size();
+      });
+      
+      std::vector<std::size_t> slots;
+      for (std::size_t b : order){
+        const std::vector<uint32_t>& bucket = buckets[b];
+        if (bucket.empty()){
+          break;
+        }
+        uint32_t seed = 0;
+        for (; seed < sMaxSeed; ++seed){
+          slots.clear();
+          bool placed = true;
+          for (uint32_t entry : bucket){
+            const std::size_t slot = slotOf(hashes[entry], seed);
+            if (mSlots[slot] != 0 || std::find(slots.begin(), slots.end(), slot) != slots.end()){
+              placed = false;
+              break;
+            }
+            slots.push_back(slot);
+          }
+          if (placed){
+            break;
+          }
+        }
+        if (seed == sMaxSeed){
+          return false;
+        }
+        mSeeds[b] = seed;
+        for (std::size_t i = 0; i < bucket.size(); ++i){
+          mSlots[slots[i]] = bucket[i] + 1;
+        }
+      }
+      return true;
+    }
+    
+    std::vector<uint32_t> mSeeds;
+    std::vector<uint32_t> mSlots;
+  };
+
+/*****************************************************
+    Setting parameters
+******************************************************/
+
+  namespace internal{
+    struct stringTag{};// -> std::string
+    
+    template<class Capacity>
+    struct fixedStringTag{};// -> inline_string<Capacity::value>
+    
+    template <typename T>
+    struct is_fixed_string_tag : public std::false_type{};
+    
+    template <typename Capacity>
+    struct is_fixed_string_tag<fixedStringTag<Capacity>> : public std::true_type{};
+
+    template<class T>
+    struct listTag{};//-> std::vector
+    
+    template <typename T>
+    struct is_list_tag : public std::false_type{};
+    
+    template <typename T>
+    struct is_list_tag<listTag<T>> : public std::true_type{};
+    
+    template<class T, class Size>
+    struct arrayTag{};//-> std::array<T, Size::value>
+    
+    template <typename T>
+    struct is_array_tag : public std::false_type{};
+    
+    template <typename T, typename Size>
+    struct is_array_tag<arrayTag<T, Size>> : public std::true_type{};
+    
+    template<class T>
+    struct setTag{};//-> hash_set
+    
+    //types whose result only stands as a whole setting, never as an element
+    template <typename T>
+    struct is_setting_only_tag : public std::integral_constant<bool, is_fixed_string_tag<T>::value || is_array_tag<T>::value>{};
+    
+    template <typename T>
+    struct is_setting_only_tag<setTag<T>> : public std::true_type{};
+    
+    struct booleanTag {};
+    struct int8Tag {};
+    struct uint8Tag {};
+    struct int16Tag {};
+    struct uint16Tag {};
+    struct int32Tag {};
+    struct uint32Tag {};
+    struct int64Tag {};
+    struct uint64Tag {};
+    struct floatTag{};
+    struct doubleTag{};
+    
+    struct optionalTag{};
+    
+    struct flatStorageTag{};// -> flat_map
+    struct frozenStorageTag{};// -> frozen_map
+    
+    struct requiredTag{};
+
+
+  }
+  static internal::stringTag string;
+  static internal::booleanTag boolean;
+  static internal::int8Tag int8;
+  static internal::uint8Tag uint8;
+  static internal::int16Tag int16;
+  static internal::uint16Tag uint16;
+  static internal::int32Tag int32;
+  static internal::uint32Tag uint32;
+  static internal::int64Tag int64;
+  static internal::uint64Tag uint64;
+  static internal::floatTag float32;
+  static internal::doubleTag float64;
+
+  //fixed_string<32>() : a string of at most 32 characters, kept in the result without allocation
+  template <std::size_t N>
+  internal::fixedStringTag<std::integral_constant<std::size_t, N>> fixed_string() {
+      return internal::fixedStringTag<std::integral_constant<std::size_t, N>>();
+  }
+  
+  template <typename T>
+  internal::listTag<T> list(T) {
+      static_assert(!internal::is_setting_only_tag<T>::value, "fixed_string, array and set are only valid as the type of a setting, not of a list element");
+      return internal::listTag<T>();
+  }
+  
+  //array<3>(float32) : exactly 3 elements, kept in the result as a std::array
+  template <std::size_t N, typename T>
+  internal::arrayTag<T, std::integral_constant<std::size_t, N>> array(T) {
+      static_assert(!internal::is_setting_only_tag<T>::value, "fixed_string, array and set are only valid as the type of a setting, not of an array element");
+      return internal::arrayTag<T, std::integral_constant<std::size_t, N>>();
+  }
+  
+  //set(string) : distinct elements, in a hash_set built once at load
+  template <typename T>
+  internal::setTag<T> set(T) {
+      static_assert(!internal::is_setting_only_tag<T>::value, "fixed_string, array and set are only valid as the type of a setting, not of a set element");
+      static_assert(!std::is_same<T, internal::booleanTag>::value && !internal::is_list_tag<T>::value, "set elements should be numbers or strings");
+      return internal::setTag<T>();
+  }
+  
+  static internal::optionalTag optional;
+  static internal::requiredTag required;
+  
+  //storage of a map's result : std::unordered_map unless one of these is given
+  static internal::flatStorageTag flat_storage;
+  static internal::frozenStorageTag frozen_storage;
+    
+/*****************************************************
+    Constraints
+******************************************************/
+
+  namespace internal{
+    namespace LengthConstraint_internal{
+      namespace LengthConstraintType{
+        enum LengthConstraintType{
+          Equal,
+          LessOrEqual,
+          Less,
+          GreaterOrEqual,
+          Greater,
+          Different
+        };
+      }
+      
+      struct Equal{
+        static bool test(size_t ref, size_t actual){
+          return ref==actual;
+        }
+        static const internal::LengthConstraint_internal::LengthConstraintType::LengthConstraintType Type = internal::LengthConstraint_internal::LengthConstraintType::Equal;
+      };
+      struct GreaterEqual{
+        static bool test(size_t ref, size_t actual){
+          return actual>=ref;
+        }
+        static const internal::LengthConstraint_internal::LengthConstraintType::LengthConstraintType Type = internal::LengthConstraint_internal::LengthConstraintType::GreaterOrEqual;
+      };
+      struct Greater{
+        static bool test(size_t ref, size_t actual){
+          return actual>ref;
+        }
+        static const internal::LengthConstraint_internal::LengthConstraintType::LengthConstraintType Type = internal::LengthConstraint_internal::LengthConstraintType::Greater;
+      };
+      struct LessEqual{
+        static bool test(size_t ref, size_t actual){
+          return actual<=ref;
+        }
+        static const internal::LengthConstraint_internal::LengthConstraintType::LengthConstraintType Type = internal::LengthConstraint_internal::LengthConstraintType::LessOrEqual;
+      };
+      struct Less{
+        static bool test(size_t ref, size_t actual){
+          return actual<ref;
+        }
+        static const internal::LengthConstraint_internal::LengthConstraintType::LengthConstraintType Type = internal::LengthConstraint_internal::LengthConstraintType::Less;
+      };
+      struct Different{
+        static bool test(size_t ref, size_t actual){
+          return actual!=ref;
+        }
+        static const internal::LengthConstraint_internal::LengthConstraintType::LengthConstraintType Type = internal::LengthConstraint_internal::LengthConstraintType::Different;
+      };
+    }
+
+
+    template <typename ConstraintT>
+    struct LengthConstraint{
+      
+      size_t mRef;
+      
+      bool validate(size_t pActual) const{
+        return ConstraintT::test(mRef, pActual);
+      }
+      
+      ConfigError getError(size_t pActual) const{
+        const char* constraintDescription = ConstraintT::Type==internal::LengthConstraint_internal::LengthConstraintType::Equal?          "equal" :
+                                            ConstraintT::Type==internal::LengthConstraint_internal::LengthConstraintType::Different?      "different from" :
+                                            ConstraintT::Type==internal::LengthConstraint_internal::LengthConstraintType::Greater?        "greater than" :
+                                            ConstraintT::Type==internal::LengthConstraint_internal::LengthConstraintType::GreaterOrEqual? "greater or equal to" :
+                                            ConstraintT::Type==internal::LengthConstraint_internal::LengthConstraintType::Less?           "less than" :
+                                                                                                                                          "less or equal to";
+        return ConfigError(error_code::length_constraint).with(internal::ErrorArgument(constraintDescription)).with(mRef).with(pActual);
+      }
+      
+    };
+    struct lengthTag{
+      LengthConstraint<internal::LengthConstraint_internal::GreaterEqual> operator>=(std::size_t rhs){
+        return LengthConstraint<internal::LengthConstraint_internal::GreaterEqual>{rhs};
+      }
+      
+      LengthConstraint<internal::LengthConstraint_internal::Greater> operator>(std::size_t rhs){
+        return LengthConstraint<internal::LengthConstraint_internal::Greater>{rhs};
+      }
+      
+      LengthConstraint<internal::LengthConstraint_internal::LessEqual> operator<=(std::size_t rhs){
+        return LengthConstraint<internal::LengthConstraint_internal::LessEqual>{rhs};
+      }
+      
+      LengthConstraint<internal::LengthConstraint_internal::Less> operator<(std::size_t rhs){
+        return LengthConstraint<internal::LengthConstraint_internal::Less>{rhs};
+      }
+      
+      LengthConstraint<internal::LengthConstraint_internal::Equal> operator==(std::size_t rhs){
+        return LengthConstraint<internal::LengthConstraint_internal::Equal>{rhs};
+      }
+      
+      LengthConstraint<internal::LengthConstraint_internal::Different> operator!=(std::size_t rhs){
+        return LengthConstraint<internal::LengthConstraint_internal::Different>{rhs};
+      }
+    };
+    
+  }
+  
+  static internal::lengthTag length;
+
+/*****************************************************
+    Built-in constraints : range, oneOf, matches,
+    unique and sorted, each checked by a policy
+    specialized on the setting's result type
+******************************************************/
+
+  namespace internal{
+
+    inline std::string DescribeValue(const std::string& value){
+      return "\""+value+"\"";
+    }
+
+    template <typename T>
+    std::string DescribeValue(const T& value){
+      return std::to_string(value);
+    }
+
+    //index of the first element failing an element-wise check, or the size of the list
+    template <typename CheckT, typename ListT>
+    std::size_t FirstFailing(const CheckT& check, const ListT& values){
+      for (std::size_t i = 0; i < values.size(); ++i){
+        if (!check.test(values[i])){
+          return i;
+        }
+      }
+      return values.size();
+    }
+
+    template <typename CheckT>
+    struct BuiltinConstraint{
+
+      CheckT mCheck;
+
+      template <typename T>
+      bool validate(const T& pActual) const{
+        return mCheck.test(pActual);
+      }
+
+      template <typename T>
+      bool validate(const std::vector<T>& pActual) const{
+        return mCheck.testAll(pActual);
+      }
+
+      template <typename T>
+      ConfigError getError(const T& pActual) const{
+        return mCheck.error(pActual);
+      }
+
+      template <typename T>
+      ConfigError getError(const std::vector<T>& pActual) const{
+        return mCheck.errorAll(pActual);
+      }
+
+      template <typename T, std::size_t N>
+      bool validate(const std::array<T, N>& pActual) const{
+        return mCheck.testAll(pActual);
+      }
+
+      template <typename T, std::size_t N>
+      ConfigError getError(const std::array<T, N>& pActual) const{
+        return mCheck.errorAll(pActual);
+      }
+
+      template <typename T>
+      bool validate(const hash_set<T>& pActual) const{
+        return mCheck.testAll(pActual);
+      }
+
+      template <typename T>
+      ConfigError getError(const hash_set<T>& pActual) const{
+        return mCheck.errorAll(pActual);
+      }
+    };
+
+    template <long long Lo, long long Hi>
+    struct RangeCheck{
+      static_assert(Lo <= Hi, "lower bound of a range constraint is greater than its upper bound");
+
+      //unsigned values are compared apart, a negative bound would wrap around
+      template <typename T>
+      static bool test(const T& value){
+        return test(value, std::is_unsigned<T>());
+      }
+
+      template <typename T>
+      static bool test(const T& value, std::true_type){
+        return (Lo <= 0 || value >= static_cast<unsigned long long>(Lo)) && Hi >= 0 && value <= static_cast<unsigned long long>(Hi);
+      }
+
+      template <typename T>
+      static bool test(const T& value, std::false_type){
+        return value >= Lo && value <= Hi;
+      }
+
+      //no early exit : the loop is left for the compiler to vectorize
+      template <typename ListT>
+      static bool testAll(const ListT& values){
+        bool inRange = true;
+        for (std::size_t i = 0; i < values.size(); ++i){
+          inRange &= test(values[i]);
+        }
+        return inRange;
+      }
+
+      template <typename T>
+      static ConfigError error(const T& value){
+        return ConfigError(error_code::range_constraint).with(Lo).with(Hi).with(value);
+      }
+
+      template <typename ListT>
+      static ConfigError errorAll(const ListT& values){
+        std::size_t index = FirstFailing(RangeCheck(), values);
+        return ConfigError(error_code::range_constraint).with(index).with(Lo).with(Hi).with(values[index]);
+      }
+    };
+
+    //bounds known at run time only, e.g. floating-point ones
+    struct IntervalCheck{
+
+      double mLo;
+      double mHi;
+
+      template <typename T>
+      bool test(const T& value) const{
+        return static_cast<double>(value) >= mLo && static_cast<double>(value) <= mHi;
+      }
+
+      template <typename ListT>
+      bool testAll(const ListT& values) const{
+        bool inRange = true;
+        for (std::size_t i = 0; i < values.size(); ++i){
+          inRange &= test(values[i]);
+        }
+        return inRange;
+      }
+
+      template <typename T>
+      ConfigError error(const T& value) const{
+        return ConfigError(error_code::range_constraint).with(mLo).with(mHi).with(value);
+      }
+
+      template <typename ListT>
+      ConfigError errorAll(const ListT& values) const{
+        std::size_t index = FirstFailing(*this, values);
+        return ConfigError(error_code::range_constraint).with(index).with(mLo).with(mHi).with(values[index]);
+      }
+    };
+
+    //type in which the choices of a oneOf constraint are kept
+    template <typename T, bool Integral = std::is_integral<T>::value, bool Floating = std::is_floating_point<T>::value>
+    struct ChoiceType{
+      typedef T type;
+    };
+
+    template <typename T>
+    struct ChoiceType<T, true, false>{
+      typedef long long type;
+    };
+
+    template <typename T>
+    struct ChoiceType<T, false, true>{
+      typedef double type;
+    };
+
+    template <>
+    struct ChoiceType<const char*, false, false>{
+      typedef std::string type;
+    };
+
+    //the choices are kept in the type common to all of them, a double as soon as one is floating-point
+    template <typename... Choices>
+    struct CommonChoiceType{
+      typedef typename ChoiceType<typename std::common_type<Choices...>::type>::type type;
+    };
+
+    //an unsigned 64 bits choice does not fit a long long, nor a long double a double
+    template <typename From, typename To>
+    struct ChoiceNarrows : public std::integral_constant<bool,
+      (std::is_integral<From>::value && std::is_integral<To>::value && std::is_unsigned<From>::value && sizeof(From) >= sizeof(To)) ||
+      (std::is_floating_point<From>::value && std::is_floating_point<To>::value && sizeof(From) > sizeof(To))>{};
+
+    template <typename To, typename... Choices>
+    struct AnyChoiceNarrows : public std::false_type{};
+
+    template <typename To, typename First, typename... Others>
+    struct AnyChoiceNarrows<To, First, Others...> : public std::integral_constant<bool, ChoiceNarrows<First, To>::value || AnyChoiceNarrows<To, Others...>::value>{};
+
+    template <typename ChoiceT>
+    struct OneOfCheck{
+
+      explicit OneOfCheck(std::vector<ChoiceT> choices)
+      : mChoices(std::move(choices))
+      , mDescription(std::make_shared<const std::string>(describeChoices())){}
+
+      std::vector<ChoiceT> mChoices;
+      //formatted once with the definition, for the errors to share
+      std::shared_ptr<const std::string> mDescription;
+
+      template <typename T>
+      bool test(const T& value) const{
+        for (std::size_t i = 0; i < mChoices.size(); ++i){
+          if (mChoices[i] == value){
+            return true;
+          }
+        }
+        return false;
+      }
+
+      template <typename ListT>
+      bool testAll(const ListT& values) const{
+        return FirstFailing(*this, values) == values.size();
+      }
+
+      template <typename T>
+      ConfigError error(const T& value) const{
+        return ConfigError(error_code::choice_constraint).with(mDescription).with(value);
+      }
+
+      template <typename ListT>
+      ConfigError errorAll(const ListT& values) const{
+        std::size_t index = FirstFailing(*this, values);
+        return ConfigError(error_code::choice_constraint).with(index).with(mDescription).with(values[index]);
+      }
+
+      std::string describeChoices() const{
+        std::string description;
+        for (std::size_t i = 0; i < mChoices.size(); ++i){
+          description += (i == 0 ? "" : ", ") + DescribeValue(mChoices[i]);
+        }
+        return description;
+      }
+    };
+
+    //the expression is compiled once, with the definition, and shared by its copies
+    struct RegexCheck{
+
+      std::shared_ptr<const std::regex> mRegex;
+      std::shared_ptr<const std::string> mDescription;
+
+      bool test(const std::string& value) const{
+        return std::regex_match(value, *mRegex);
+      }
+
+      template <std::size_t N>
+      bool test(const inline_string<N>& value) const{
+        return std::regex_match(value.begin(), value.end(), *mRegex);
+      }
+
+      template <typename ListT>
+      bool testAll(const ListT& values) const{
+        return FirstFailing(*this, values) == values.size();
+      }
+
+      template <typename T>
+      ConfigError error(const T& value) const{
+        return ConfigError(error_code::pattern_constraint).with(mDescription).with(value);
+      }
+
+      template <typename ListT>
+      ConfigError errorAll(const ListT& values) const{
+        std::size_t index = FirstFailing(*this, values);
+        return ConfigError(error_code::pattern_constraint).with(index).with(mDescription).with(values[index]);
+      }
+    };
+
+    //finds the first element equal to an earlier one, in one pass over a hash table of the elements seen
+    template <typename ListT>
+    bool FindDuplicate(const ListT& values, std::size_t& first, std::size_t& second){
+      typedef typename ListT::value_type value_type;
+      typedef std::reference_wrapper<const value_type> key_type;
+      std::unordered_map<key_type, std::size_t, std::hash<value_type>, std::equal_to<value_type>> seen;
+      seen.reserve(values.size());
+      for (std::size_t i = 0; i < values.size(); ++i){
+        auto inserted = seen.insert(std::make_pair(key_type(values[i]), i));
+        if (!inserted.second){
+          first = inserted.first->second;
+          second = i;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    inline bool FindDuplicate(const std::vector<bool>& values, std::size_t& first, std::size_t& second){
+      std::size_t seen[2] = {values.size(), values.size()};
+      for (std::size_t i = 0; i < values.size(); ++i){
+        std::size_t& previous = seen[values[i] ? 1 : 0];
+        if (previous != values.size()){
+          first = previous;
+          second = i;
+          return true;
+        }
+        previous = i;
       }
-      
-      LengthConstraint<internal::LengthConstraint_internal::Less> operator<(std::size_t rhs){
-        return LengthConstraint<internal::LengthConstraint_internal::Less>{rhs};
+      return false;
+    }
+
+    struct UniqueCheck{
+
+      template <typename ListT>
+      bool testAll(const ListT& values) const{
+        std::size_t first, second;
+        return !FindDuplicate(values, first, second);
       }
-      
-      LengthConstraint<internal::LengthConstraint_internal::Equal> operator==(std::size_t rhs){
-        return LengthConstraint<internal::LengthConstraint_internal::Equal>{rhs};
+
+      template <typename ListT>
+      ConfigError errorAll(const ListT& values) const{
+        std::size_t first = 0, second = 0;
+        FindDuplicate(values, first, second);
+        return ConfigError(error_code::uniqueness_constraint).with(first).with(second).with(values[second]);
       }
-      
-      LengthConstraint<internal::LengthConstraint_internal::Different> operator!=(std::size_t rhs){
-        return LengthConstraint<internal::LengthConstraint_internal::Different>{rhs};
+    };
+
+    struct SortedCheck{
+
+      template <typename ListT>
+      bool testAll(const ListT& values) const{
+        return std::is_sorted(values.begin(), values.end());
+      }
+
+      template <typename ListT>
+      ConfigError errorAll(const ListT& values) const{
+        std::size_t index = std::is_sorted_until(values.begin(), values.end()) - values.begin();
+        return ConfigError(error_code::order_constraint).with(index).with(index-1).with(values[index]).with(values[index-1]);
       }
     };
-    
+
+    template <typename T>
+    struct is_range_constraint : public std::false_type{};
+
+    template <long long Lo, long long Hi>
+    struct is_range_constraint<BuiltinConstraint<RangeCheck<Lo,Hi>>> : public std::true_type{};
+
+    template <>
+    struct is_range_constraint<BuiltinConstraint<IntervalCheck>> : public std::true_type{};
+
+    //whether the values an element-wise check sees are strings, for a list, an array or a set its elements
+    template <typename T>
+    struct checks_strings : public std::false_type{};
+
+    template <>
+    struct checks_strings<std::string> : public std::true_type{};
+
+    template <std::size_t N>
+    struct checks_strings<inline_string<N>> : public std::true_type{};
+
+    template <typename T>
+    struct checks_strings<std::vector<T>> : public checks_strings<T>{};
+
+    template <typename T, std::size_t N>
+    struct checks_strings<std::array<T, N>> : public checks_strings<T>{};
+
+    template <typename T>
+    struct checks_strings<hash_set<T>> : public checks_strings<T>{};
+
   }
-  
-  static internal::lengthTag length;
-  
+
+  //range<0,100>() : integer bounds, both included
+  template <long long Lo, long long Hi>
+  internal::BuiltinConstraint<internal::RangeCheck<Lo,Hi>> range(){
+    return internal::BuiltinConstraint<internal::RangeCheck<Lo,Hi>>();
+  }
+
+  //range(0.1, 2.5) : bounds known at run time, both included
+  inline internal::BuiltinConstraint<internal::IntervalCheck> range(double lo, double hi){
+    return internal::BuiltinConstraint<internal::IntervalCheck>{internal::IntervalCheck{lo, hi}};
+  }
+
+  //oneOf(1, 2.5) keeps both choices as doubles
+  template <typename First, typename... Others>
+  internal::BuiltinConstraint<internal::OneOfCheck<typename internal::CommonChoiceType<First, Others...>::type>> oneOf(First first, Others... others){
+    typedef typename internal::CommonChoiceType<First, Others...>::type choice_type;
+    static_assert(!internal::AnyChoiceNarrows<choice_type, First, Others...>::value, "a choice of oneOf does not fit the type common to all the choices");
+    return internal::BuiltinConstraint<internal::OneOfCheck<choice_type>>{internal::OneOfCheck<choice_type>{std::vector<choice_type>{choice_type(first), choice_type(others)...}}};
+  }
+
+  //the whole string must match ; throws std::regex_error when the pattern is invalid
+  inline internal::BuiltinConstraint<internal::RegexCheck> matches(const std::string& pattern){
+    return internal::BuiltinConstraint<internal::RegexCheck>{internal::RegexCheck{std::make_shared<const std::regex>(pattern, std::regex::ECMAScript | std::regex::optimize), std::make_shared<const std::string>(internal::DescribeValue(pattern))}};
+  }
+
+  static internal::BuiltinConstraint<internal::UniqueCheck> unique;
+  static internal::BuiltinConstraint<internal::SortedCheck> sorted;
+
   /*****************************************************
     FunctorConstraint : a generic constraint that
     checks the result of a functor
@@ -490,7 +2045,7 @@ namespace icfg{
     
     template <typename ParameterT>
     ConfigError getError(const ParameterT& pActual) const{
-      return ConfigError("Constraint validation \""+Name().getString()+"\" failed.");
+      return ConfigError(error_code::check_constraint).with(internal::ErrorArgument(&Name::getString));
     }
   };
   
@@ -588,6 +2143,13 @@ namespace icfg{
       }
     };
     
+    template <typename CheckT>
+    struct IsSettingDefDynParameter<BuiltinConstraint<CheckT>>{
+      static auto extract(const BuiltinConstraint<CheckT>& param) -> std::tuple<BuiltinConstraint<CheckT>>{
+        return std::tuple<BuiltinConstraint<CheckT>>(param);
+      }
+    };
+    
     template <uint64_t Q1, uint64_t Q2, uint64_t Q3, uint64_t Q4, typename CallableT>
     struct IsSettingDefDynParameter<FunctorConstraint<settingName<Q1,Q2,Q3,Q4>, CallableT>>{
       static auto extract(const FunctorConstraint<settingName<Q1,Q2,Q3,Q4>, CallableT>& param) -> std::tuple<FunctorConstraint<settingName<Q1,Q2,Q3,Q4>, CallableT>>{
@@ -613,6 +2175,422 @@ namespace icfg{
       return std::tuple_cat(IsSettingDefDynParameter<Params>::extract(params)...);
     }
 
+/*****************************************************
+    Load context : how the settings are bound
+******************************************************/
+
+    /*
+      What the checks must know of the binding : the settings that couldn't
+      be bound hold no value to check, nor do the groups holding them.
+      Results are found by their address, stable once bound
+    */
+    struct BindingRecord{
+      //settings that failed to bind, with the errors they reported
+      std::unordered_map<const void*, std::vector<ConfigError>> failedSettings;
+      //groups one setting of which, at any depth, failed to bind : their checks are skipped
+      std::unordered_set<const void*> failedGroups;
+      //entries of each unordered map, in the order of the document they were bound in
+      std::unordered_map<const void*, std::vector<const void*>> entryOrders;
+    };
+    
+    class WorkerPool;
+
+    struct LoadContext{
+      LoadContext()
+      : validate(true)
+      , validationThreads(1)
+      , maxErrors(0)
+      , errorCount(nullptr)
+      , record(nullptr)
+      , replayBindingErrors(false)
+      , recordEntryOrder(false)
+      , pool(nullptr){}
+      
+      //once maxErrors are reported, what is left to bind or check is skipped
+      bool stopped() const {
+        return errorCount != nullptr && errorCount->load() >= maxErrors;
+      }
+      
+      //counts the errors found, when they are capped
+      std::vector<ConfigError> reported(std::vector<ConfigError> errors) const {
+        if (errorCount != nullptr){
+          *errorCount += errors.size();
+        }
+        return errors;
+      }
+      
+      //constraints are checked while binding, unless they are left to a pass of their own
+      bool validate;
+      //threads the entries of a map are validated by
+      unsigned validationThreads;
+      //errors the load stops at, none when 0
+      std::size_t maxErrors;
+      //errors reported so far by the load, shared by its threads ; only set when maxErrors is
+      std::atomic<std::size_t>* errorCount;
+      //filled while binding, then read by the checks of groups and by a separate validation pass
+      BindingRecord* record;
+      //the separate pass reports the recorded binding errors too, each where the setting lies
+      bool replayBindingErrors;
+      //the binding records the order of the entries of unordered maps, for a separate pass reporting in that order
+      bool recordEntryOrder;
+      //threads the separate pass shares out the entries of a map to, none when it runs alone
+      WorkerPool* pool;
+    };
+    
+    //whether one setting of the group, at any depth, failed to bind
+    inline bool BindingFailedIn(const void* group, const LoadContext& context){
+      return context.record != nullptr && context.record->failedGroups.count(group) > 0;
+    }
+    
+    //threads started once for a load, running the tasks posted to them until the pool is destroyed
+    class WorkerPool{
+    
+    public:
+      explicit WorkerPool(unsigned threads)
+      : mStopping(false){
+        mThreads.reserve(threads);
+        for (unsigned t = 0; t < threads; ++t){
+          mThreads.push_back(std::thread([this]{ run(); }));
+        }
+      }
+      
+      WorkerPool(const WorkerPool&) = delete;
+      WorkerPool& operator=(const WorkerPool&) = delete;
+      
+      ~WorkerPool(){
+        {
+          std::lock_guard<std::mutex> lock(mMutex);
+          mStopping = true;
+        }
+        mWakeUp.notify_all();
+        for (std::size_t t = 0; t < mThreads.size(); ++t){
+          mThreads[t].join();
+        }
+      }
+      
+      std::size_t size() const {
+        return mThreads.size();
+      }
+      
+      void post(std::function<void()> task){
+        {
+          std::lock_guard<std::mutex> lock(mMutex);
+          mTasks.push_back(std::move(task));
+        }
+        mWakeUp.notify_one();
+      }
+      
+    private:
+      void run(){
+        for (;;){
+          std::function<void()> task;
+          {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWakeUp.wait(lock, [this]{ return mStopping || !mTasks.empty(); });
+            if (mTasks.empty()){
+              return;
+            }
+            task = std::move(mTasks.front());
+            mTasks.pop_front();
+          }
+          task();
+        }
+      }
+      
+      std::vector<std::thread> mThreads;
+      std::deque<std::function<void()>> mTasks;
+      std::mutex mMutex;
+      std::condition_variable mWakeUp;
+      bool mStopping;
+    };
+    
+    //runs task(0) to task(count-1) on the calling thread and the threads of the pool, each taking the next index left ; the first failing index rethrows
+    template <typename Task>
+    void ParallelFor(std::size_t count, WorkerPool& pool, Task task){
+      std::atomic<std::size_t> next(0);
+      std::vector<std::exception_ptr> failures(count);
+      auto worker = [&]{
+        for (std::size_t i = next++; i < count; i = next++){
+          try{
+            task(i);
+          }
+          catch (...){
+            failures[i] = std::current_exception();
+          }
+        }
+      };
+      
+      //the tasks posted refer to this frame : it is left once every one of them is done
+      std::size_t helpers = count > 1 ? std::min<std::size_t>(pool.size(), count - 1) : 0;
+      std::mutex doneMutex;
+      std::condition_variable done;
+      for (std::size_t h = 0; h < helpers; ++h){
+        pool.post([&]{
+          worker();
+          std::lock_guard<std::mutex> lock(doneMutex);
+          if (--helpers == 0){
+            done.notify_one();
+          }
+        });
+      }
+      worker();
+      {
+        std::unique_lock<std::mutex> lock(doneMutex);
+        done.wait(lock, [&]{ return helpers == 0; });
+      }
+      
+      for (std::size_t i = 0; i < count; ++i){
+        if (failures[i]){
+          std::rethrow_exception(failures[i]);
+        }
+      }
+    }
+    
+    template <typename Executor>
+    struct BackgroundValidation{
+      Executor executor;
+    };
+    
+  }
+  
+  //options of a load, e.g. def.load(loader, icfg::load_options().validation_threads(8))
+  class load_options{
+  
+  public:
+    load_options()
+    : mContext(){}
+    
+    //the constraints of map entries are checked by up to threads threads, once every setting is bound ;
+    //the errors are reported in the same order as with a single thread ; with max_errors, the whole document is still bound and checked
+    load_options& validation_threads(unsigned threads){
+      mContext.validationThreads = threads == 0 ? 1 : threads;
+      return *this;
+    }
+    
+    //the load stops at the first error : the settings left are neither bound nor checked
+    load_options& fail_fast(){
+      return max_errors(1);
+    }
+    
+    //the load stops once n errors are reported, and reports no more than n ; 0 lifts the cap
+    load_options& max_errors(std::size_t n){
+      mContext.maxErrors = n;
+      return *this;
+    }
+    
+    const internal::LoadContext& context() const {
+      return mContext;
+    }
+    
+  private:
+    internal::LoadContext mContext;
+  };
+  
+  //load option : constraints are checked by a task handed to the executor, once every setting is bound
+  template <typename Executor>
+  internal::BackgroundValidation<Executor> validate_in_background(Executor executor){
+    return internal::BackgroundValidation<Executor>{executor};
+  }
+  
+  /*
+    Result of a load whose constraints are checked in the background : the
+    bound values are usable right away, the outcome of the validation is
+    delivered through the validation future
+  */
+  template <typename ResultT>
+  class early_result{
+  
+  public:
+    early_result(const std::shared_ptr<ResultT>& pResult, const std::shared_future<std::vector<ConfigError>>& pValidation)
+    : mResult(pResult)
+    , mValidation(pValidation){}
+    
+    //the binding errors only, constraint failures are reported by validation() ; read-only, as the validation reads it too
+    const ResultT& result() const {
+      return *mResult;
+    }
+    
+    //the constraint failures, located in the file when the loader has a locator()
+    const std::shared_future<std::vector<ConfigError>>& validation() const {
+      return mValidation;
+    }
+    
+  private:
+    std::shared_ptr<ResultT> mResult;
+    std::shared_future<std::vector<ConfigError>> mValidation;
+  };
+  
+  namespace internal{
+
+/*****************************************************
+    Asynchronous load
+******************************************************/
+
+    //loads a definition with the loader built by the factory, the outcome being handed to the promise
+    template <class Definition, class LoaderFactory>
+    void LoadInto(const Definition& definition, LoaderFactory& loaderFactory, std::promise<typename Definition::result_type>& promise){
+      try{
+        promise.set_value(definition.load(loaderFactory()));
+      }
+      catch (...){
+        promise.set_exception(std::current_exception());
+      }
+    }
+    
+#if __cplusplus >= 202002L
+    //co_await-able load : runs on the executor, then resumes the awaiting coroutine on the resume executor
+    template <class Definition, class LoaderFactory, class Executor, class ResumeExecutor>
+    struct LoadAwaitable{
+      typedef typename Definition::result_type result_type;
+      
+      Definition mDefinition;
+      LoaderFactory mLoaderFactory;
+      Executor mExecutor;
+      ResumeExecutor mResumeExecutor;
+      std::promise<result_type> mPromise;
+      
+      bool await_ready() const noexcept{
+        return false;
+      }
+      
+      void await_suspend(std::coroutine_handle<> awaiting){
+        mExecutor([this, awaiting]{
+          LoadInto(mDefinition, mLoaderFactory, mPromise);
+          mResumeExecutor([awaiting]{ awaiting.resume(); });
+        });
+      }
+      
+      result_type await_resume(){
+        return mPromise.get_future().get();
+      }
+    };
+#endif
+
+/*****************************************************
+    Error locations : paths are given to the errors
+    as they go up the definition, and the loader
+    finds where they lie once the load is over
+******************************************************/
+
+    //errors of a setting or a group, about paths below its name
+    inline std::vector<ConfigError> WithinSetting(std::vector<ConfigError> errors, const std::string& name){
+      for (auto& error : errors){
+        error.prefixPath(name);
+      }
+      return errors;
+    }
+    
+    //loaders able to locate errors provide void locate(std::vector<ConfigError>&) const
+    template <typename Loader>
+    struct has_locate{
+      typedef char yes[1];
+      typedef char no[2];
+
+      template <typename L>
+      static yes& test(decltype(std::declval<const L&>().locate(std::declval<std::vector<ConfigError>&>()))*);
+
+      template <typename>
+      static no& test(...);
+
+      static const bool value = sizeof(test<Loader>(0)) == sizeof(yes);
+    };
+    
+    template <typename Loader>
+    void LocateErrors(const Loader& loader, std::vector<ConfigError>& errors, std::true_type){
+      if (!errors.empty()){
+        loader.locate(errors);
+      }
+    }
+    
+    template <typename Loader>
+    void LocateErrors(const Loader&, std::vector<ConfigError>&, std::false_type){
+    }
+    
+    template <typename Loader>
+    void LocateErrors(const Loader& loader, std::vector<ConfigError>& errors){
+      LocateErrors(loader, errors, std::integral_constant<bool, has_locate<Loader>::value>());
+    }
+
+    //loaders able to locate errors once they are gone provide a locator() const, returning
+    //a callable that keeps what it needs, e.g. the file name, and not the loader itself
+    template <typename Loader>
+    struct has_locator{
+      typedef char yes[1];
+      typedef char no[2];
+
+      template <typename L>
+      static yes& test(decltype(std::declval<const L&>().locator())*);
+
+      template <typename>
+      static no& test(...);
+
+      static const bool value = sizeof(test<Loader>(0)) == sizeof(yes);
+    };
+    
+    typedef std::function<void(std::vector<ConfigError>&)> ErrorLocator;
+    
+    template <typename Loader>
+    ErrorLocator LocatorOf(const Loader& loader, std::true_type){
+      return loader.locator();
+    }
+    
+    template <typename Loader>
+    ErrorLocator LocatorOf(const Loader&, std::false_type){
+      return ErrorLocator();
+    }
+    
+    //empty when the loader has no locator : the errors are then left without a location
+    template <typename Loader>
+    ErrorLocator LocatorOf(const Loader& loader){
+      return LocatorOf(loader, std::integral_constant<bool, has_locator<Loader>::value>());
+    }
+
+    //loaders still reading the document while it is bound provide void finishBinding() const,
+    //throwing as a loader does when the part of the document no setting asked for is invalid
+    template <typename Loader>
+    struct has_finish_binding{
+      typedef char yes[1];
+      typedef char no[2];
+
+      template <typename L>
+      static yes& test(decltype(std::declval<const L&>().finishBinding())*);
+
+      template <typename>
+      static no& test(...);
+
+      static const bool value = sizeof(test<Loader>(0)) == sizeof(yes);
+    };
+    
+    template <typename Loader>
+    void FinishBinding(const Loader& loader, std::true_type){
+      loader.finishBinding();
+    }
+    
+    template <typename Loader>
+    void FinishBinding(const Loader&, std::false_type){
+    }
+    
+    template <typename Loader>
+    void FinishBinding(const Loader& loader){
+      FinishBinding(loader, std::integral_constant<bool, has_finish_binding<Loader>::value>());
+    }
+
+/*****************************************************
+    Group constraints : check() functors given to a
+    config, section, map or case, called with the
+    bound group
+******************************************************/
+
+    template <typename Constraints, typename GroupT>
+    std::vector<ConfigError> ValidateGroup(const Constraints& constraints, const GroupT& group, const std::string& groupName){
+      std::vector<ConfigError> errors;
+      ValidateParameters<0,std::tuple_size<Constraints>::value>::validate(constraints, group, errors);
+      for(auto& err : errors)   {
+        err.setFailingSettingName(groupName);
+      }
+      return errors;
+    }
+
 /*****************************************************
     config 
 ******************************************************/
@@ -624,6 +2602,7 @@ namespace icfg{
     struct configDef{
       template <typename ConfigBackend>
       friend struct ConfigValueLoader_t;
+      friend struct ConfigValueValidator_t;
 
       typedef typename MakeConfigResult<Params...>::type result_type;
       
@@ -633,23 +2612,145 @@ namespace icfg{
     private:
       std::tuple<Params...> content;
 
+      decltype(MakeSettingDefDynParametersTuple(std::declval<std::tuple<Params...>>())) constraints;
+
     public:
       configDef(const std::tuple<Params...>& params)
-      : content(params){
+      : content(params)
+      , constraints(MakeSettingDefDynParametersTuple(params)){
       
       }
       
       template <class ConfigBackend>
       result_type load(const ConfigBackend& loader) const{
         result_type result;
-        std::vector<ConfigError> errors = ConfigValueLoader_t<ConfigBackend>::load(loader, result, *this);
+        BindingRecord record;
+        LoadContext context;
+        context.record = &record;
+        std::vector<ConfigError> errors = ConfigValueLoader_t<ConfigBackend>::load(loader, result, *this, context);
+        FinishBinding(loader);
+        LocateErrors(loader, errors);
+        result.setErrors(errors);
+        return result;
+      }
+      
+      template <class ConfigBackend>
+      result_type load(const ConfigBackend& loader, const load_options& options) const{
+        result_type result;
+        LoadContext context = options.context();
+        std::atomic<std::size_t> errorCount(0);
+        if (context.maxErrors > 0){
+          context.errorCount = &errorCount;
+        }
+        //parallel validation needs every setting bound first
+        const bool separateValidation = context.validationThreads > 1;
+        context.validate = !separateValidation;
+        BindingRecord record;
+        context.record = &record;
+        if (separateValidation){
+          //which errors come first is only known once the constraints are checked : nothing is skipped, the errors are capped below
+          context.errorCount = nullptr;
+          context.recordEntryOrder = true;
+        }
+        std::vector<ConfigError> errors = ConfigValueLoader_t<ConfigBackend>::load(loader, result, *this, context);
+        FinishBinding(loader);
+        if (separateValidation){
+          //the pass reports the binding errors again, among the constraint failures in the order of the document
+          WorkerPool pool(context.validationThreads - 1);
+          LoadContext validationContext(context);
+          validationContext.replayBindingErrors = true;
+          validationContext.pool = &pool;
+          errors = ValidateBoundResult(result, *this, validationContext);
+        }
+        //a group may report several errors at once
+        if (context.maxErrors > 0 && errors.size() > context.maxErrors){
+          errors.erase(errors.begin() + context.maxErrors, errors.end());
+        }
+        LocateErrors(loader, errors);
         result.setErrors(errors);
         return result;
       }
       
+      //the settings are bound first, their constraints then checked by a task handed to the executor
+      template <class ConfigBackend, class Executor>
+      early_result<result_type> load(const ConfigBackend& loader, const BackgroundValidation<Executor>& option) const{
+        std::shared_ptr<result_type> result = std::make_shared<result_type>();
+        std::shared_ptr<BindingRecord> record = std::make_shared<BindingRecord>();
+        LoadContext context;
+        context.validate = false;
+        context.record = record.get();
+        std::vector<ConfigError> errors = ConfigValueLoader_t<ConfigBackend>::load(loader, *result, *this, context);
+        FinishBinding(loader);
+        LocateErrors(loader, errors);
+        result->setErrors(errors);
+        
+        std::shared_ptr<std::promise<std::vector<ConfigError>>> validation = std::make_shared<std::promise<std::vector<ConfigError>>>();
+        early_result<result_type> early(result, validation->get_future().share());
+        const configDef definition(*this);
+        Executor executor(option.executor);
+        std::shared_ptr<const result_type> boundResult(result);
+        //the loader may be gone by the time the validation fails
+        ErrorLocator locate = LocatorOf(loader);
+        executor([definition, boundResult, record, validation, locate]{
+          try{
+            LoadContext validationContext;
+            validationContext.record = record.get();
+            std::vector<ConfigError> validationErrors = ValidateBoundResult(*boundResult, definition, validationContext);
+            if (locate && !validationErrors.empty()){
+              locate(validationErrors);
+            }
+            validation->set_value(std::move(validationErrors));
+          }
+          catch (...){
+            validation->set_exception(std::current_exception());
+          }
+        });
+        return early;
+      }
+      
+      //consume mode : the loader is taken over, its document being freed as soon as the settings are bound
+      template <class ConfigBackend, typename = typename std::enable_if<!std::is_lvalue_reference<ConfigBackend>::value>::type>
+      result_type load(ConfigBackend&& loader) const{
+        const ConfigBackend consumedLoader(std::move(loader));
+        return load(consumedLoader);
+      }
+      
+      //the loader is built and the configuration loaded by a task handed to the executor, any callable accepting a void() task
+      template <class LoaderFactory, class Executor>
+      std::future<result_type> load_async(LoaderFactory loaderFactory, Executor&& executor) const{
+        std::shared_ptr<std::promise<result_type>> promise = std::make_shared<std::promise<result_type>>();
+        std::future<result_type> future = promise->get_future();
+        const configDef definition(*this);
+        executor([definition, loaderFactory, promise]() mutable {
+          LoadInto(definition, loaderFactory, *promise);
+        });
+        return future;
+      }
+      
+      //same, the completion handler then being called on the caller's executor with the ready future
+      template <class LoaderFactory, class Executor, class CallerExecutor, class CompletionHandler>
+      void load_async(LoaderFactory loaderFactory, Executor&& executor, CallerExecutor callerExecutor, CompletionHandler handler) const{
+        const configDef definition(*this);
+        executor([definition, loaderFactory, callerExecutor, handler]() mutable {
+          std::shared_ptr<std::promise<result_type>> promise = std::make_shared<std::promise<result_type>>();
+          LoadInto(definition, loaderFactory, *promise);
+          callerExecutor([promise, handler]() mutable {
+            handler(promise->get_future());
+          });
+        });
+      }
+      
+#if __cplusplus >= 202002L
+      //co_await def.load_awaitable(factory, executor, resumeExecutor) : the awaiting coroutine is resumed on resumeExecutor
+      template <class LoaderFactory, class Executor, class ResumeExecutor>
+      LoadAwaitable<configDef, LoaderFactory, Executor, ResumeExecutor> load_awaitable(LoaderFactory loaderFactory, Executor executor, ResumeExecutor resumeExecutor) const{
+        return LoadAwaitable<configDef, LoaderFactory, Executor, ResumeExecutor>{*this, loaderFactory, executor, resumeExecutor, std::promise<result_type>()};
+      }
+#endif
+      
     private:
-      std::vector<ConfigError> validate(const result_type& ) const {
-        return std::vector<ConfigError>();
+      std::vector<ConfigError> validate(const result_type& result) const {
+        return ValidateGroup(constraints, result.result, "");
       }
     };
 
@@ -661,6 +2762,7 @@ namespace icfg{
     struct settingDef{
       template <typename ConfigBackend>
       friend struct ConfigValueLoader_t;
+      friend struct ConfigValueValidator_t;
       
       typedef typename MakeSettingResult<Params...>::type result_type;
       
@@ -693,21 +2795,25 @@ namespace icfg{
     struct sectionDef{
       template <typename ConfigBackend>
       friend struct ConfigValueLoader_t;
+      friend struct ConfigValueValidator_t;
       
       typedef typename MakeSectionResult<Params...>::type result_type;
       
     private:
       std::tuple<Params...> content;
 
+      decltype(MakeSettingDefDynParametersTuple(std::declval<std::tuple<Params...>>())) constraints;
+
     public:
       sectionDef(const std::tuple<Params...>& params)
-      : content(params){
+      : content(params)
+      , constraints(MakeSettingDefDynParametersTuple(params)){
       
       }
       
     private:
-      std::vector<ConfigError> validate(const result_type& ) const {
-        return std::vector<ConfigError>();
+      std::vector<ConfigError> validate(const result_type& result) const {
+        return ValidateGroup(constraints, result.value, result_type::myName::getString());
       }
     };
 
@@ -719,21 +2825,38 @@ namespace icfg{
     struct mapDef{
       template <typename ConfigBackend>
       friend struct ConfigValueLoader_t;
+      friend struct ConfigValueValidator_t;
         
       typedef typename MakeMapResult<Params...>::type result_type;
       
     private:
       std::tuple<Params...> content;
 
+      decltype(MakeSettingDefDynParametersTuple(std::declval<std::tuple<Params...>>())) constraints;
+
     public:
       mapDef(const std::tuple<Params...>& params)
-      : content(params){
+      : content(params)
+      , constraints(MakeSettingDefDynParametersTuple(params)){
       
       }
       
     private:
-      std::vector<ConfigError> validate(const result_type& ) const {
-        return std::vector<ConfigError>();
+      //each entry is a group of its own ; the entries skipped hold a setting that failed to bind
+      template <typename Skipped>
+      std::vector<ConfigError> validate(const result_type& result, Skipped skipped) const {
+        std::vector<ConfigError> errors;
+        if (std::tuple_size<decltype(constraints)>::value == 0){
+          return errors;
+        }
+        for (const auto& entry : result.value){
+          if (skipped(&entry.second)){
+            continue;
+          }
+          std::vector<ConfigError> entryErrors = WithinSetting(ValidateGroup(constraints, entry.second, result_type::myName::getString()+"["+entry.first+"]"), entry.first);
+          errors.insert(errors.end(), entryErrors.begin(), entryErrors.end());
+        }
+        return errors;
       }
 
     };
@@ -781,6 +2904,7 @@ namespace icfg{
     struct switchDef{
       template <typename ConfigBackend>
       friend struct ConfigValueLoader_t;
+      friend struct ConfigValueValidator_t;
         
       typedef typename MakeSwitchResult<Params...>::type result_type;
       
@@ -809,21 +2933,25 @@ namespace icfg{
     struct caseDef{
       template <typename ConfigBackend>
       friend struct ConfigValueLoader_t;
+      friend struct ConfigValueValidator_t;
         
       typedef typename MakeCaseResult<Params...>::type result_type;
       
     private:
       std::tuple<Params...> content;
 
+      decltype(MakeSettingDefDynParametersTuple(std::declval<std::tuple<Params...>>())) constraints;
+
     public:
       caseDef(const std::tuple<Params...>& params)
-      : content(params){
+      : content(params)
+      , constraints(MakeSettingDefDynParametersTuple(params)){
       
       }
       
     private:
-      std::vector<ConfigError> validate(const result_type& ) const {
-        return std::vector<ConfigError>();
+      std::vector<ConfigError> validate(const result_type& result) const {
+        return ValidateGroup(constraints, result.result, result_type::myName::getString());
       }
 
     };
@@ -1035,6 +3163,22 @@ namespace icfg{
       CHECK_ALLOWED_UNROLL_PARAM_8(PARAMS, P1, P2, P3, P4, P5, P12, P13, P16 ), \
       CHECK_ALLOWED_UNROLL_PARAM_8(PARAMS, P6, P7, P8, P9, P10, P11, P14, P15 )
 
+    #define CHECK_ALLOWED_UNROLL_PARAM_17(PARAMS, P1, P2, P3, P4, P5, P6, P7, P8, P9, P10, P11, P12, P13, P14, P15, P16, P17) \
+      CHECK_ALLOWED_UNROLL_PARAM_1( PARAMS,P1 ), \
+      CHECK_ALLOWED_UNROLL_PARAM_16(PARAMS, P2, P3, P4, P5, P6, P7, P8, P9, P10, P11, P12, P13, P14, P15, P16, P17)
+
+    #define CHECK_ALLOWED_UNROLL_PARAM_18(PARAMS, P1, P2, P3, P4, P5, P6, P7, P8, P9, P10, P11, P12, P13, P14, P15, P16, P17, P18) \
+      CHECK_ALLOWED_UNROLL_PARAM_1( PARAMS,P1 ), \
+      CHECK_ALLOWED_UNROLL_PARAM_17(PARAMS, P2, P3, P4, P5, P6, P7, P8, P9, P10, P11, P12, P13, P14, P15, P16, P17, P18)
+
+    #define CHECK_ALLOWED_UNROLL_PARAM_19(PARAMS, P1, P2, P3, P4, P5, P6, P7, P8, P9, P10, P11, P12, P13, P14, P15, P16, P17, P18, P19) \
+      CHECK_ALLOWED_UNROLL_PARAM_1( PARAMS,P1 ), \
+      CHECK_ALLOWED_UNROLL_PARAM_18(PARAMS, P2, P3, P4, P5, P6, P7, P8, P9, P10, P11, P12, P13, P14, P15, P16, P17, P18, P19)
+
+    #define CHECK_ALLOWED_UNROLL_PARAM_20(PARAMS, P1, P2, P3, P4, P5, P6, P7, P8, P9, P10, P11, P12, P13, P14, P15, P16, P17, P18, P19, P20) \
+      CHECK_ALLOWED_UNROLL_PARAM_1( PARAMS,P1 ), \
+      CHECK_ALLOWED_UNROLL_PARAM_19(PARAMS, P2, P3, P4, P5, P6, P7, P8, P9, P10, P11, P12, P13, P14, P15, P16, P17, P18, P19, P20)
+
     #define CALL_CHECK_ALLOWED_UNROLL_PARAM(MACRO, PARAMS) MACRO PARAMS
       
     #define CHECK_ALLOWED(N, CONTEXT, PARAMS, ...)                  \
@@ -1088,6 +3232,35 @@ namespace icfg{
       static const bool value = sizeof(test<ConstraintT>(0)) == sizeof(yes);
     };
     
+    struct CallOperatorProbe{
+      void operator()();
+    };
+    
+    template <typename T>
+    struct WithCallOperatorProbe : T, CallOperatorProbe{
+    };
+    
+    //a call operator that is a template, as for group checks, has no address to take :
+    //it is found through the ambiguity it brings to a class inheriting the probe's one too
+    template <typename T, bool IsClass = std::is_class<T>::value>
+    struct has_call_operator : public std::false_type{
+    };
+    
+    template <typename T>
+    struct has_call_operator<T, true>{
+      
+      typedef char yes[1];
+      typedef char no[2];
+
+      template <typename CType>
+      static no& test(decltype(&WithCallOperatorProbe<CType>::operator()));
+
+      template <typename>
+      static yes& test(...);
+
+      static const bool value = sizeof(test<T>(0)) == sizeof(yes);
+    };
+    
     template <typename T>
     struct is_functor{
       
@@ -1100,7 +3273,7 @@ namespace icfg{
       template <typename>
       static no& test(...);
 
-      static const bool value = sizeof(test<T>(0)) == sizeof(yes);
+      static const bool value = sizeof(test<T>(0)) == sizeof(yes) || (!isName<typename std::decay<T>::type>::value && has_call_operator<typename std::decay<T>::type>::value);
     };
     
   }
@@ -1115,11 +3288,15 @@ namespace icfg{
     using namespace internal;
     CHECK_FORBIDDEN(config, caseOf, caseDef, Params);
     CHECK_FORBIDDEN(config, list, listTag, Params);
+    CHECK_FORBIDDEN(config, array, arrayTag, Params);
+    CHECK_FORBIDDEN(config, set, setTag, Params);
     CHECK_FORBIDDEN(config, string, stringTag, Params);
+    CHECK_FORBIDDEN(config, fixed_string, fixedStringTag, Params);
     CHECK_FORBIDDEN(config, settingName, settingName, Params);
     CHECK_FORBIDDEN(config, length constraint, LengthConstraint, Params);
+    CHECK_FORBIDDEN(config, constraint, BuiltinConstraint, Params);
     
-    CHECK_ALLOWED(6, config, Params, settingDef, switchDef, sectionDef, std::tuple, configDef, mapDef);
+    CHECK_ALLOWED(7, config, Params, settingDef, switchDef, sectionDef, std::tuple, configDef, mapDef, FunctorConstraint);
     
     return internal::make_configDef(std::tuple_cat(internal::tuplifyOne(params)...));
   }
@@ -1136,7 +3313,7 @@ namespace icfg{
     CHECK_FORBIDDEN(setting, setting, settingDef, Params);
     CHECK_FORBIDDEN(setting, section, sectionDef, Params);
     
-    CHECK_ALLOWED( 16, setting, Params, settingName, listTag, stringTag, LengthConstraint, FunctorConstraint, booleanTag, int8Tag, uint8Tag, int16Tag, uint16Tag, int32Tag, uint32Tag, int64Tag, uint64Tag, floatTag, doubleTag);
+    CHECK_ALLOWED( 20, setting, Params, settingName, listTag, arrayTag, setTag, stringTag, fixedStringTag, LengthConstraint, FunctorConstraint, BuiltinConstraint, booleanTag, int8Tag, uint8Tag, int16Tag, uint16Tag, int32Tag, uint32Tag, int64Tag, uint64Tag, floatTag, doubleTag);
     
     CHECK_REQUIRED(setting, settingName, settingName, Params);
     CHECK_UNIQUE(setting, settingName, settingName, Params);
@@ -1146,7 +3323,10 @@ namespace icfg{
     static_assert(
       internal::one_true<
         ICFG_IS(stringTag),
+        ICFG_IS(fixedStringTag),
         ICFG_IS(listTag),
+        ICFG_IS(arrayTag),
+        ICFG_IS(setTag),
         ICFG_IS(booleanTag),
         ICFG_IS(int8Tag),
         ICFG_IS(uint8Tag),
@@ -1163,7 +3343,10 @@ namespace icfg{
     static_assert(
       !internal::more_than_one_true<
         ICFG_IS(stringTag),
+        ICFG_IS(fixedStringTag),
         ICFG_IS(listTag),
+        ICFG_IS(arrayTag),
+        ICFG_IS(setTag),
         ICFG_IS(booleanTag),
         ICFG_IS(int8Tag),
         ICFG_IS(uint8Tag),
@@ -1197,6 +3380,35 @@ namespace icfg{
       "length is not a valid constraint for numbers setting type."
     );
     
+    static_assert(
+      internal::one_true<ICFG_IS(arrayTag)>::value ?
+      !internal::one_true<
+        decltype(internal::is_one_or_instance_of<LengthConstraint>(std::declval<Params>()))::value...
+      >::value : true,
+      "length is not a valid constraint for array setting type, its length is fixed."
+    );
+    
+    static_assert(
+      internal::one_true<ICFG_IS(listTag), ICFG_IS(arrayTag)>::value ? true :
+      !internal::one_true<
+        ICFG_IS(BuiltinConstraint<UniqueCheck>),
+        ICFG_IS(BuiltinConstraint<SortedCheck>)
+      >::value,
+      "unique and sorted are only valid constraints for list and array setting types."
+    );
+    
+    static_assert(
+      internal::checks_strings<typename internal::settingDef<Params...>::result_type::myType>::value ?
+      !internal::one_true<internal::is_range_constraint<Params>::value...>::value : true,
+      "range is not a valid constraint for string setting types."
+    );
+    
+    static_assert(
+      internal::checks_strings<typename internal::settingDef<Params...>::result_type::myType>::value ? true :
+      !internal::one_true<ICFG_IS(BuiltinConstraint<RegexCheck>)>::value,
+      "matches is only a valid constraint for string setting types."
+    );
+    
     #undef ICFG_IS
     
     //check FunctorConstraint's validity
@@ -1218,10 +3430,14 @@ namespace icfg{
     using namespace internal;
     CHECK_FORBIDDEN(section, caseOf, caseDef, Params);
     CHECK_FORBIDDEN(section, list, listTag, Params);
+    CHECK_FORBIDDEN(section, array, arrayTag, Params);
+    CHECK_FORBIDDEN(section, set, setTag, Params);
     CHECK_FORBIDDEN(section, string, stringTag, Params);
+    CHECK_FORBIDDEN(section, fixed_string, fixedStringTag, Params);
     CHECK_FORBIDDEN(section, length constraint, LengthConstraint, Params);
+    CHECK_FORBIDDEN(section, constraint, BuiltinConstraint, Params);
     
-    CHECK_ALLOWED(6, section, Params, settingName, switchDef, settingDef, std::tuple, mapDef, sectionDef);
+    CHECK_ALLOWED(7, section, Params, settingName, switchDef, settingDef, std::tuple, mapDef, sectionDef, FunctorConstraint);
     
     CHECK_REQUIRED(section, settingName, settingName, Params);
     CHECK_UNIQUE(section, settingName, settingName, Params);
@@ -1231,6 +3447,7 @@ namespace icfg{
 
   template <typename... Params>
   internal::mapDef<Params...> map(Params... params){
+    static_assert(!internal::all_true<internal::one_true<std::is_same<Params, internal::flatStorageTag>::value...>::value, internal::one_true<std::is_same<Params, internal::frozenStorageTag>::value...>::value>::value, "a map has only one storage");
     return internal::mapDef<Params...>(std::tuple_cat(internal::tuplifyOne(params)...));
   }
 
@@ -1243,9 +3460,13 @@ namespace icfg{
     CHECK_FORBIDDEN(switchOn, switchOn, switchDef, Params);
     CHECK_FORBIDDEN(switchOn, map, mapDef, Params);
     CHECK_FORBIDDEN(switchOn, list, listTag, Params);
+    CHECK_FORBIDDEN(switchOn, array, arrayTag, Params);
+    CHECK_FORBIDDEN(switchOn, set, setTag, Params);
     CHECK_FORBIDDEN(switchOn, string, stringTag, Params);
+    CHECK_FORBIDDEN(switchOn, fixed_string, fixedStringTag, Params);
     CHECK_FORBIDDEN(switchOn, config, configDef, Params);
     CHECK_FORBIDDEN(switchOn, length constraint, LengthConstraint, Params);
+    CHECK_FORBIDDEN(switchOn, constraint, BuiltinConstraint, Params);
     
     CHECK_ALLOWED(2, switchOn, Params, caseDef, settingName);
     
@@ -1262,11 +3483,15 @@ namespace icfg{
     using namespace internal;
     CHECK_FORBIDDEN(caseOf, caseOf, caseDef, Params);
     CHECK_FORBIDDEN(caseOf, list, listTag, Params);
+    CHECK_FORBIDDEN(caseOf, array, arrayTag, Params);
+    CHECK_FORBIDDEN(caseOf, set, setTag, Params);
     CHECK_FORBIDDEN(caseOf, string, stringTag, Params);
+    CHECK_FORBIDDEN(caseOf, fixed_string, fixedStringTag, Params);
     CHECK_FORBIDDEN(caseOf, config, configDef, Params);
     CHECK_FORBIDDEN(caseOf, length constraint, LengthConstraint, Params);
+    CHECK_FORBIDDEN(caseOf, constraint, BuiltinConstraint, Params);
     
-    CHECK_ALLOWED(6, caseOf, Params, settingName, switchDef, settingDef, std::tuple, mapDef, sectionDef);
+    CHECK_ALLOWED(7, caseOf, Params, settingName, switchDef, settingDef, std::tuple, mapDef, sectionDef, FunctorConstraint);
     
     CHECK_REQUIRED(caseOf, settingName, settingName, Params);
     CHECK_UNIQUE(caseOf, settingName, settingName, Params);
@@ -1296,9 +3521,13 @@ namespace icfg{
     CHECK_FORBIDDEN(check, caseOf, switchDef, Params);
     CHECK_FORBIDDEN(check, map, mapDef, Params);
     CHECK_FORBIDDEN(check, list, listTag, Params);
+    CHECK_FORBIDDEN(check, array, arrayTag, Params);
+    CHECK_FORBIDDEN(check, set, setTag, Params);
     CHECK_FORBIDDEN(check, string, stringTag, Params);
+    CHECK_FORBIDDEN(check, fixed_string, fixedStringTag, Params);
     CHECK_FORBIDDEN(check, config, configDef, Params);
     CHECK_FORBIDDEN(check, length constraint, LengthConstraint, Params);
+    CHECK_FORBIDDEN(check, constraint, BuiltinConstraint, Params);
     
     CHECK_REQUIRED(check, settingName, settingName, Params);
     CHECK_UNIQUE(check, settingName, settingName, Params);
@@ -1455,6 +3684,30 @@ namespace icfg{
     // DECLARE_TYPE_EXTRACTOR_FOR(int32_t, int32_t);
     // DECLARE_TYPE_EXTRACTOR_FOR(uint64_t, uint64_t);
     // DECLARE_TYPE_EXTRACTOR_FOR(int64_t, int64_t);
+    template <typename Capacity, typename... Params>
+    struct ExtractResultType<fixedStringTag<Capacity>, Params...>{
+      typedef inline_string<Capacity::value> type;
+    };
+    template <typename Capacity>
+    struct ExtractResultType<fixedStringTag<Capacity>>{
+      typedef inline_string<Capacity::value> type;
+    };
+    template <typename SubT, typename Size, typename... Params>
+    struct ExtractResultType<arrayTag<SubT, Size>, Params...>{
+      typedef std::array<typename ExtractResultType<SubT>::type, Size::value> type;
+    };
+    template <typename SubT, typename Size>
+    struct ExtractResultType<arrayTag<SubT, Size>>{
+      typedef std::array<typename ExtractResultType<SubT>::type, Size::value> type;
+    };
+    template <typename SubT, typename... Params>
+    struct ExtractResultType<setTag<SubT>, Params...>{
+      typedef hash_set<typename ExtractResultType<SubT>::type> type;
+    };
+    template <typename SubT>
+    struct ExtractResultType<setTag<SubT>>{
+      typedef hash_set<typename ExtractResultType<SubT>::type> type;
+    };
     template <typename SubT, typename... Params>
     struct ExtractResultType<listTag<SubT>, Params...>{
       typedef std::vector<typename ExtractResultType<SubT>::type> type;
@@ -1498,9 +3751,29 @@ namespace icfg{
     of the given map
 ******************************************************/
 
+    template <typename GroupT, typename... Params>
+    struct ExtractMapStorage{
+      typedef std::unordered_map<std::string, GroupT> type;
+    };
+
+    template <typename GroupT, typename FirstParam, typename... Params>
+    struct ExtractMapStorage<GroupT, FirstParam, Params...>{
+      typedef typename ExtractMapStorage<GroupT, Params...>::type type;
+    };
+
+    template <typename GroupT, typename... Params>
+    struct ExtractMapStorage<GroupT, flatStorageTag, Params...>{
+      typedef flat_map<GroupT> type;
+    };
+
+    template <typename GroupT, typename... Params>
+    struct ExtractMapStorage<GroupT, frozenStorageTag, Params...>{
+      typedef frozen_map<GroupT> type;
+    };
+
     template <typename... Params>
     struct MakeMapResult{
-      typedef settingResult<typename ExtractSettingName<Params...>::result,std::unordered_map<std::string, typename MakeConfigResultWithoutName<Params...>::type>> type;
+      typedef settingResult<typename ExtractSettingName<Params...>::result, typename ExtractMapStorage<typename MakeConfigResultWithoutName<Params...>::type, Params...>::type> type;
     };
 
 /*****************************************************
@@ -1692,6 +3965,26 @@ namespace icfg{
       }
     };
 
+    template <typename T, std::size_t N>
+    struct ApplyConstraintCheck<LengthConstraint<T>,inline_string<N>>{
+      static bool validate(const LengthConstraint<T>& constraint, const inline_string<N>& result){
+        return constraint.validate(result.size());
+      }
+      static ConfigError getError(const LengthConstraint<T>& constraint, const inline_string<N>& result){
+        return constraint.getError(result.size());
+      }
+    };
+
+    template <typename T, typename U>
+    struct ApplyConstraintCheck<LengthConstraint<T>,hash_set<U>>{
+      static bool validate(const LengthConstraint<T>& constraint, const hash_set<U>& result){
+        return constraint.validate(result.size());
+      }
+      static ConfigError getError(const LengthConstraint<T>& constraint, const hash_set<U>& result){
+        return constraint.getError(result.size());
+      }
+    };
+
     template <typename U, typename T>
     struct ApplyConstraintCheck<LengthConstraint<U>,std::vector<T>>{
       static bool validate(const LengthConstraint<T>& constraint, const std::string& result){
@@ -1702,6 +3995,16 @@ namespace icfg{
       }
     };
     
+    template <typename CheckT, typename ResultType>
+    struct ApplyConstraintCheck<BuiltinConstraint<CheckT>, ResultType>{
+      static bool validate(const BuiltinConstraint<CheckT>& constraint, const ResultType& result){
+        return constraint.validate(result);
+      }
+      static ConfigError getError(const BuiltinConstraint<CheckT>& constraint, const ResultType& result){
+        return constraint.getError(result);
+      }
+    };
+    
     template <uint64_t Q1, uint64_t Q2, uint64_t Q3, uint64_t Q4, typename CallableT, typename ResultType>
     struct ApplyConstraintCheck<FunctorConstraint<settingName<Q1,Q2,Q3,Q4>, CallableT>, ResultType>{
       static bool validate(const FunctorConstraint<settingName<Q1,Q2,Q3,Q4>, CallableT>& constraint, const ResultType& result){
@@ -1845,6 +4148,11 @@ namespace icfg{
         return std::get<index>(settings);
       }
       
+      template <size_t index>
+      auto getNthSetting() const -> typename std::add_lvalue_reference<typename std::add_const<typename std::tuple_element<index, myTupleType>::type>::type>::type{
+        return std::get<index>(settings);
+      }
+      
       template <size_t index>
       struct getNthSettingType{
         typedef typename std::tuple_element<index, myTupleType>::type type;
@@ -1857,6 +4165,12 @@ namespace icfg{
         return std::get<ExtractSettingFromName<Name,Values...>::index>(settings).get();
       }
       
+      template <typename Name>
+      auto get(Name = Name()) const -> typename std::add_lvalue_reference<typename std::add_const<typename ExtractSettingFromName<Name,Values...>::result::myType>::type>::type{
+        static_assert(!std::is_same<typename ExtractSettingFromName<Name,Values...>::result,empty_t>::value, "Setting does not exist in the configuration");
+        return std::get<ExtractSettingFromName<Name,Values...>::index>(settings).get();
+      }
+      
     };
 
     /*****************************************************
@@ -1959,6 +4273,14 @@ namespace icfg{
         return *reinterpret_cast<typename ExtractCaseFromName<settingName,Cases...>::result*>(&storage);
       }
       
+      template<typename settingName>
+      auto getCase(settingName) const -> typename std::add_lvalue_reference<typename std::add_const<typename ExtractCaseFromName<settingName,Cases...>::result>::type>::type{
+        if (settingName::getString()!=activeValue){
+          throw std::string("bad union access : "+settingName::getString()+" whereas "+activeValue+" is active");
+        }
+        return *reinterpret_cast<const typename ExtractCaseFromName<settingName,Cases...>::result*>(&storage);
+      }
+      
       template<typename settingName>
       void setCase(const settingName& name, const typename ExtractCaseFromName<settingName,Cases...>::result& value){
         defineMember(name);
@@ -1982,12 +4304,12 @@ namespace icfg{
         return *this;
       }
       
-      operator std::string(){
+      operator std::string() const{
         return activeValue;
       }
       
       template <typename Visitor>
-      void visitCase(const std::string& name, Visitor& visitor){
+      void visitCase(const std::string& name, Visitor& visitor) const{
         GetCaseNameFromStr<Cases...>::template call<myType>(name, visitor);
       }
       
@@ -2027,12 +4349,12 @@ namespace icfg{
       
       template <typename SettingName>
       auto get(SettingName) -> decltype(result.template get<SettingName>()){
-        return result.get<SettingName>();
+        return result.template get<SettingName>();
       }
       
       template <typename SettingName>
       auto getSetting(SettingName) -> decltype(result.template getSetting<SettingName>()){
-        return result.getSetting<SettingName>();
+        return result.template getSetting<SettingName>();
       }
     };
 
@@ -2048,6 +4370,7 @@ namespace icfg{
       
       template <typename>
       friend struct ConfigValueLoader_t;
+      friend struct ConfigValueValidator_t;
       
     private:
       groupResult<Params...> result;
@@ -2080,7 +4403,15 @@ namespace icfg{
         if (hasError()){
           throw std::string("Cannot access  config when error occured");
         }
-        return result.get<Name>();
+        return result.template get<Name>();
+      }
+      
+      template <typename Name>
+      auto get(Name) const -> decltype(result.template get<Name>()){
+        if (hasError()){
+          throw std::string("Cannot access  config when error occured");
+        }
+        return result.template get<Name>();
       }
       
       template <typename Name>
@@ -2088,14 +4419,14 @@ namespace icfg{
         if (hasError()){
           throw std::string("Cannot access  config when error occured");
         }
-        return result.getSetting<Name>();
+        return result.template getSetting<Name>();
       }
       
       bool hasError() const{
         return errors.size()>0;
       }
       
-      const std::vector<ConfigError>& getErrors(){
+      const std::vector<ConfigError>& getErrors() const{
         return errors;
       }
       
@@ -2116,7 +4447,9 @@ namespace icfg{
       
       myType value;
       
-      settingResult(){}
+      //a setting left unbound holds its type's zero rather than garbage
+      settingResult()
+      : value(){}
       
       settingResult(myType val)
       : value(val){}
@@ -2139,12 +4472,15 @@ namespace icfg{
     struct ConfigGroupLoader_t{
 
       template <typename ConfigBackend, typename... DefParams, typename... ResParams>
-      static std::vector<ConfigError> load(const std::tuple<DefParams...>& definition, groupResult<ResParams...>& result, const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue){
+      static std::vector<ConfigError> load(const std::tuple<DefParams...>& definition, groupResult<ResParams...>& result, const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, const LoadContext& context){
+        if (context.stopped()){
+          return std::vector<ConfigError>();
+        }
         auto& resElm = result.template getNthSetting<index>();
         const auto& defElm = std::get<ExtractSettingFromName<typename std::decay<decltype(resElm)>::type::myName, DefParams...>::index>(definition);
         std::string settingName = std::decay<decltype(resElm)>::type::myName::getString();
-        std::vector<ConfigError> errors = ConfigValueLoader_t<ConfigBackend>::load(configLoader, parentValue, settingName, resElm, defElm);
-        std::vector<ConfigError> nextErrors = ConfigGroupLoader_t<index+1,size>::load(definition, result, configLoader, parentValue);
+        std::vector<ConfigError> errors = ConfigValueLoader_t<ConfigBackend>::load(configLoader, parentValue, settingName, resElm, defElm, context);
+        std::vector<ConfigError> nextErrors = ConfigGroupLoader_t<index+1,size>::load(definition, result, configLoader, parentValue, context);
         errors.insert(errors.end(), nextErrors.begin(), nextErrors.end());
         return errors;
       }
@@ -2153,7 +4489,7 @@ namespace icfg{
     template <size_t index>
     struct ConfigGroupLoader_t<index,index>{
       template <typename ConfigBackend, typename... DefParams, typename... ResParams>
-      static std::vector<ConfigError> load(const std::tuple<DefParams...>& definition,groupResult<ResParams...>& config, const ConfigBackend&, const typename ConfigBackend::ValueType&){
+      static std::vector<ConfigError> load(const std::tuple<DefParams...>& definition,groupResult<ResParams...>& config, const ConfigBackend&, const typename ConfigBackend::ValueType&, const LoadContext&){
         return std::vector<ConfigError>();
       }
     };
@@ -2165,34 +4501,84 @@ namespace icfg{
       const typename ConfigBackend::ValueType& mParentValue;
       SwitchType& mSwitchRes;
       const switchDef<SettingName, DefParams...>& mDefinition;
+      const LoadContext& mContext;
       
       std::vector<ConfigError> mErrors;
 
-      caseResultLoaderVisitor(ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, SwitchType& switchRes, const switchDef<SettingName, DefParams...>& definition)
+      caseResultLoaderVisitor(ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, SwitchType& switchRes, const switchDef<SettingName, DefParams...>& definition, const LoadContext& context)
       : mConfigLoader(configLoader)
       , mParentValue(parentValue)
       , mSwitchRes(switchRes)
-      , mDefinition(definition){}
+      , mDefinition(definition)
+      , mContext(context){}
 
       template <typename Name>
       void function(){
-        mErrors = ConfigValueLoader_t<ConfigBackend>::load(mConfigLoader, mParentValue, mSwitchRes.getCase(Name()), mDefinition.getCase(Name()));
+        mErrors = ConfigValueLoader_t<ConfigBackend>::load(mConfigLoader, mParentValue, mSwitchRes.getCase(Name()), mDefinition.getCase(Name()), mContext);
       }
     };
 
     template <typename ConfigBackend, typename SwitchType, typename SettingName, typename... DefParams>
-    caseResultLoaderVisitor<ConfigBackend,SwitchType,SettingName,DefParams...> make_caseResultLoaderVisitor(ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, SwitchType& switchRes, const switchDef<SettingName, DefParams...>& definition){
-      return caseResultLoaderVisitor<ConfigBackend,SwitchType,SettingName,DefParams...>(configLoader, parentValue, switchRes, definition);
+    caseResultLoaderVisitor<ConfigBackend,SwitchType,SettingName,DefParams...> make_caseResultLoaderVisitor(ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, SwitchType& switchRes, const switchDef<SettingName, DefParams...>& definition, const LoadContext& context){
+      return caseResultLoaderVisitor<ConfigBackend,SwitchType,SettingName,DefParams...>(configLoader, parentValue, switchRes, definition, context);
     }
 
     template <typename ConfigBackend>
     struct ConfigValueLoader_t{
 
+      //constraints of the definition, unless they are checked in a separate pass
+      template <typename Definition, typename SettingResType>
+      static std::vector<ConfigError> validated(const Definition& definition, const SettingResType& setting, const LoadContext& context){
+        if (!context.validate || context.stopped()){
+          return std::vector<ConfigError>();
+        }
+        return context.reported(definition.validate(setting));
+      }
+      
+      //settings failed to bind so far, for a group to tell whether one of its own did
+      static std::size_t failures(const LoadContext& context){
+        return context.record == nullptr ? 0 : context.record->failedSettings.size();
+      }
+      
+      //constraints of a group, skipped when one of its settings failed to bind since failuresBefore
+      template <typename Definition, typename GroupResType>
+      static std::vector<ConfigError> validatedGroup(const Definition& definition, const GroupResType& group, std::size_t failuresBefore, const LoadContext& context){
+        if (failures(context) != failuresBefore){
+          context.record->failedGroups.insert(&group);
+          return std::vector<ConfigError>();
+        }
+        return validated(definition, group, context);
+      }
+      
+      //constraints of the entries of a map, but those one setting of which failed to bind
+      template <typename MapDefinition, typename MapResType>
+      static std::vector<ConfigError> validatedMap(const MapDefinition& definition, const MapResType& setting, const LoadContext& context){
+        if (!context.validate || context.stopped()){
+          return std::vector<ConfigError>();
+        }
+        return context.reported(definition.validate(setting, [&context](const void* entry){ return BindingFailedIn(entry, context); }));
+      }
+      
+      //errors of a setting left unbound, recorded for a separate validation pass to skip it
+      template <typename SettingResType>
+      static std::vector<ConfigError> failed(const SettingResType& setting, std::vector<ConfigError> errors, const LoadContext& context){
+        if (context.record != nullptr){
+          context.record->failedSettings[&setting] = errors;
+        }
+        return context.reported(std::move(errors));
+      }
+      
+      template <typename SettingResType>
+      static std::vector<ConfigError> missing(const SettingResType& setting, const std::string& settingName, const LoadContext& context){
+        return failed(setting, WithinSetting(std::vector<ConfigError>({ConfigError(error_code::missing_setting)}), settingName), context);
+      }
+
       //load config
       template<typename... DefParams, typename... ResParams>
-      static std::vector<ConfigError> load(const ConfigBackend& configLoader, configResult<ResParams...>& setting, const configDef<DefParams...>& definition){
-        std::vector<ConfigError> errors = ConfigGroupLoader_t<0,groupResult<ResParams...>::size>::load(definition.content, setting.result, configLoader, configLoader.getRoot());
-        std::vector<ConfigError> groupErrors = definition.validate(setting);
+      static std::vector<ConfigError> load(const ConfigBackend& configLoader, configResult<ResParams...>& setting, const configDef<DefParams...>& definition, const LoadContext& context){
+        const std::size_t failuresBefore = failures(context);
+        std::vector<ConfigError> errors = ConfigGroupLoader_t<0,groupResult<ResParams...>::size>::load(definition.content, setting.result, configLoader, configLoader.getRoot(), context);
+        std::vector<ConfigError> groupErrors = validatedGroup(definition, setting, failuresBefore, context);
         errors.insert(errors.end(), groupErrors.begin(), groupErrors.end());
         return errors;
         
@@ -2200,85 +4586,203 @@ namespace icfg{
       
       //load setting
       template <typename SettingResType, typename SettingName, typename... DefParams>
-      static std::vector<ConfigError> load(const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, const std::string& settingName,  SettingResType& setting, const settingDef<SettingName, DefParams...>& definition){
+      static std::vector<ConfigError> load(const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, const std::string& settingName,  SettingResType& setting, const settingDef<SettingName, DefParams...>& definition, const LoadContext& context){
         if (configLoader.hasValue(parentValue, settingName)){
           configLoader.getValue(parentValue, settingName, setting.value);
-          return definition.validate(setting);
+          return WithinSetting(validated(definition, setting, context), settingName);
         } else {
-          return std::vector<ConfigError>({ConfigError("The required setting "+settingName+" wasn't found in the configuration")});
+          return missing(setting, settingName, context);
         }
         
       }
       
+      //load fixed-capacity string : read as any string, then checked against its capacity
+      template <typename ResName, std::size_t N, typename SettingName, typename... DefParams>
+      static std::vector<ConfigError> load(const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, const std::string& settingName, settingResult<ResName, inline_string<N>>& setting, const settingDef<SettingName, DefParams...>& definition, const LoadContext& context){
+        if (configLoader.hasValue(parentValue, settingName)){
+          std::string text;
+          configLoader.getValue(parentValue, settingName, text);
+          if (!setting.value.assign(text.data(), text.size())){
+            return failed(setting, WithinSetting(std::vector<ConfigError>({ConfigError(error_code::length_constraint).with(ErrorArgument("less or equal to")).with(N).with(text.size())}), settingName), context);
+          }
+          return WithinSetting(validated(definition, setting, context), settingName);
+        } else {
+          return missing(setting, settingName, context);
+        }
+      }
+      
+      //load fixed-size array : read as a list, which must hold exactly N elements
+      template <typename ResName, typename T, std::size_t N, typename SettingName, typename... DefParams>
+      static std::vector<ConfigError> load(const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, const std::string& settingName, settingResult<ResName, std::array<T, N>>& setting, const settingDef<SettingName, DefParams...>& definition, const LoadContext& context){
+        if (configLoader.hasValue(parentValue, settingName)){
+          std::vector<T> values;
+          configLoader.getValue(parentValue, settingName, values);
+          if (values.size() != N){
+            return failed(setting, WithinSetting(std::vector<ConfigError>({ConfigError(error_code::length_constraint).with(ErrorArgument("equal")).with(N).with(values.size())}), settingName), context);
+          }
+          std::copy(values.begin(), values.end(), setting.value.begin());
+          return WithinSetting(validated(definition, setting, context), settingName);
+        } else {
+          return missing(setting, settingName, context);
+        }
+      }
+      
+      //load set : read as a list, whose elements must be distinct ; the first of equal elements is kept
+      template <typename ResName, typename T, typename SettingName, typename... DefParams>
+      static std::vector<ConfigError> load(const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, const std::string& settingName, settingResult<ResName, hash_set<T>>& setting, const settingDef<SettingName, DefParams...>& definition, const LoadContext& context){
+        if (configLoader.hasValue(parentValue, settingName)){
+          std::vector<T> values;
+          configLoader.getValue(parentValue, settingName, values);
+          
+          std::vector<ConfigError> errors;
+          //position in the list of each element kept, for the errors to name the first occurence
+          std::vector<std::size_t> positions;
+          positions.reserve(values.size());
+          setting.value.reserve(values.size());
+          for (std::size_t i = 0; i < values.size(); ++i){
+            std::size_t existing = 0;
+            if (setting.value.insert(values[i], &existing)){
+              positions.push_back(i);
+            }
+            else {
+              errors.push_back(ConfigError(error_code::uniqueness_constraint).with(positions[existing]).with(i).with(values[i]));
+            }
+          }
+          
+          if (!errors.empty()){
+            return failed(setting, WithinSetting(errors, settingName), context);
+          }
+          return WithinSetting(validated(definition, setting, context), settingName);
+        } else {
+          return missing(setting, settingName, context);
+        }
+      }
+      
       //load section
       template<typename SettingName, typename... DefParams, typename... ResParams>
-      static std::vector<ConfigError> load(const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, const std::string& settingName, settingResult<SettingName, groupResult<ResParams...>>& setting, const sectionDef<DefParams...>& definition){
+      static std::vector<ConfigError> load(const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, const std::string& settingName, settingResult<SettingName, groupResult<ResParams...>>& setting, const sectionDef<DefParams...>& definition, const LoadContext& context){
         
         if (configLoader.hasValue(parentValue, settingName)){
-          ConfigGroupLoader_t<0,groupResult<ResParams...>::size>::load(definition.content, setting.value, configLoader, configLoader.getContainedValue(parentValue, settingName));
-          return definition.validate(setting);
+          const std::size_t failuresBefore = failures(context);
+          std::vector<ConfigError> errors = ConfigGroupLoader_t<0,groupResult<ResParams...>::size>::load(definition.content, setting.value, configLoader, configLoader.getContainedValue(parentValue, settingName), context);
+          std::vector<ConfigError> validationErrors = validatedGroup(definition, setting, failuresBefore, context);
+          errors.insert(errors.end(), validationErrors.begin(), validationErrors.end());
+          return WithinSetting(errors, settingName);
         } else {
-          return std::vector<ConfigError>({ConfigError("The required setting "+settingName+" wasn't found in the configuration")});
+          return missing(setting, settingName, context);
         }
       }
       
       //load map
       template<typename SettingName, typename... DefParams, typename... ResParams>
-      static std::vector<ConfigError> load(const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, const std::string& settingName, settingResult<SettingName, std::unordered_map<std::string,groupResult<ResParams...>>>& setting, const mapDef<DefParams...>& definition){
+      static std::vector<ConfigError> load(const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, const std::string& settingName, settingResult<SettingName, std::unordered_map<std::string,groupResult<ResParams...>>>& setting, const mapDef<DefParams...>& definition, const LoadContext& context){
+        
+        if (configLoader.hasValue(parentValue, settingName)){
+          std::vector<ConfigError> errors;
+          const typename ConfigBackend::ValueType& mapConfigVal = configLoader.getContainedValue(parentValue, settingName);
+          std::vector<const void*>* entryOrder = context.recordEntryOrder ? &context.record->entryOrders[&setting] : nullptr;
+          //single pass over the members : no key list is built and no lookup is done per key
+          configLoader.forEachChild(mapConfigVal, [&](const std::string& valueName, const typename ConfigBackend::ValueType& configVal){
+            if (context.stopped()){
+              return;
+            }
+            auto entry = setting.value.insert(std::make_pair(valueName, groupResult<ResParams...>()));
+            if (!entry.second){
+              //duplicated key : the first occurence is kept
+              return;
+            }
+            if (entryOrder != nullptr){
+              entryOrder->push_back(&*entry.first);
+            }
+            const std::size_t failuresBefore = failures(context);
+            std::vector<ConfigError> groupLoadErrors = WithinSetting(ConfigGroupLoader_t<0,groupResult<ResParams...>::size>::load(definition.content, entry.first->second, configLoader, configVal, context), valueName);
+            errors.insert(errors.end(), groupLoadErrors.begin(), groupLoadErrors.end());
+            if (failures(context) != failuresBefore){
+              context.record->failedGroups.insert(&entry.first->second);
+            }
+          });
+          std::vector<ConfigError> validationErrors = validatedMap(definition, setting, context);
+          errors.insert(errors.end(), validationErrors.begin(), validationErrors.end());
+          return WithinSetting(errors, settingName);
+        } else {
+          return missing(setting, settingName, context);
+        }
+      }
+      
+      //load map built once at load : the entries are sorted by key, and loaded in that order
+      template<typename SettingName, template <typename> class MapT, typename... DefParams, typename... ResParams>
+      static std::vector<ConfigError> load(const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, const std::string& settingName, settingResult<SettingName, MapT<groupResult<ResParams...>>>& setting, const mapDef<DefParams...>& definition, const LoadContext& context){
         
         if (configLoader.hasValue(parentValue, settingName)){
+          typedef std::pair<std::string, const typename ConfigBackend::ValueType*> member_type;
+          std::vector<member_type> members;
+          configLoader.forEachChild(configLoader.getContainedValue(parentValue, settingName), [&](const std::string& valueName, const typename ConfigBackend::ValueType& configVal){
+            members.push_back(member_type(valueName, &configVal));
+          });
+          //duplicated key : the first occurence is kept
+          std::stable_sort(members.begin(), members.end(), [](const member_type& lhs, const member_type& rhs){ return lhs.first < rhs.first; });
+          members.erase(std::unique(members.begin(), members.end(), [](const member_type& lhs, const member_type& rhs){ return lhs.first == rhs.first; }), members.end());
+          
           std::vector<ConfigError> errors;
-          typename ConfigBackend::ValueType mapConfigVal = configLoader.getContainedValue(parentValue, settingName);
-          std::vector<std::string> values = configLoader.getContainedValues(mapConfigVal);
-          for (auto& valueName : values){
-            typename ConfigBackend::ValueType configVal = configLoader.getContainedValue(mapConfigVal, valueName);
-            groupResult<ResParams...> result;
-            std::vector<ConfigError> groupLoadErrors = ConfigGroupLoader_t<0,groupResult<ResParams...>::size>::load(definition.content, result, configLoader, configVal);
-            setting.value.insert(std::make_pair(valueName, result));
+          setting.value.reserve(members.size());
+          for (auto& member : members){
+            if (context.stopped()){
+              break;
+            }
+            groupResult<ResParams...>& entry = setting.value.append(member.first);
+            const std::size_t failuresBefore = failures(context);
+            std::vector<ConfigError> groupLoadErrors = WithinSetting(ConfigGroupLoader_t<0,groupResult<ResParams...>::size>::load(definition.content, entry, configLoader, *member.second, context), member.first);
             errors.insert(errors.end(), groupLoadErrors.begin(), groupLoadErrors.end());
+            if (failures(context) != failuresBefore){
+              context.record->failedGroups.insert(&entry);
+            }
           }
-          std::vector<ConfigError> validationErrors = definition.validate(setting);
+          setting.value.seal();
+          
+          std::vector<ConfigError> validationErrors = validatedMap(definition, setting, context);
           errors.insert(errors.end(), validationErrors.begin(), validationErrors.end());
-          return errors;
+          return WithinSetting(errors, settingName);
         } else {
-          return std::vector<ConfigError>({ConfigError("The required setting "+settingName+" wasn't found in the configuration")});
+          return missing(setting, settingName, context);
         }
       }
       
       //load switch
       template <typename SettingResType, typename SettingName, typename... DefParams>
-      static std::vector<ConfigError> load(const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, const std::string& settingName, SettingResType& setting, const switchDef<SettingName, DefParams...>& definition){
+      static std::vector<ConfigError> load(const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, const std::string& settingName, SettingResType& setting, const switchDef<SettingName, DefParams...>& definition, const LoadContext& context){
         if (configLoader.hasValue(parentValue, settingName)){
           std::string switchValue;
           configLoader.getValue(parentValue, settingName, switchValue);
           setting.activateCase(switchValue);
           
-          auto visitor = make_caseResultLoaderVisitor(configLoader, parentValue, setting, definition);
+          auto visitor = make_caseResultLoaderVisitor(configLoader, parentValue, setting, definition, context);
           setting.visitCase(switchValue, visitor);
-          std::vector<ConfigError> validationErrors = definition.validate(setting);
+          //the settings of the case lie beside the switch, not below it
+          std::vector<ConfigError> validationErrors = WithinSetting(validated(definition, setting, context), settingName);
           visitor.mErrors.insert(visitor.mErrors.end(), validationErrors.begin(), validationErrors.end());
           return visitor.mErrors;
         } else {
-          return std::vector<ConfigError>({ConfigError("The required setting "+settingName+" wasn't found in the configuration")});
+          return missing(setting, settingName, context);
         }
         
       }
       
         //load case
       template <typename SettingResType, typename SettingName, typename... DefParams>
-      static std::vector<ConfigError> load(const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, SettingResType& setting, const caseDef<SettingName, DefParams...>& definition){
-        std::vector<ConfigError> errors = ConfigGroupLoader_t<0,decltype(setting.result)::size>::load(definition.content, setting.result, configLoader, parentValue);
-        std::vector<ConfigError> groupErrors = definition.validate(setting);
+      static std::vector<ConfigError> load(const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, SettingResType& setting, const caseDef<SettingName, DefParams...>& definition, const LoadContext& context){
+        const std::size_t failuresBefore = failures(context);
+        std::vector<ConfigError> errors = ConfigGroupLoader_t<0,decltype(setting.result)::size>::load(definition.content, setting.result, configLoader, parentValue, context);
+        std::vector<ConfigError> groupErrors = validatedGroup(definition, setting, failuresBefore, context);
         errors.insert(errors.end(), groupErrors.begin(), groupErrors.end());
         return errors;
       }
       
       //load optional setting
       template <typename SettingResType, typename SettingName, typename... DefParams>
-      static std::vector<ConfigError> load(const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, const std::string& settingName,  std::optional<SettingResType>& setting, const settingDef<SettingName, DefParams...>& definition){
+      static std::vector<ConfigError> load(const ConfigBackend& configLoader, const typename ConfigBackend::ValueType& parentValue, const std::string& settingName,  std::optional<SettingResType>& setting, const settingDef<SettingName, DefParams...>& definition, const LoadContext& context){
         if (configLoader.hasValue(parentValue, settingName)){
           configLoader.getValue(parentValue, settingName, setting);
-          return definition.validate(setting);
+          return WithinSetting(validated(definition, setting, context), settingName);
         } else {
           //nothing for optional
           return std::vector<ConfigError>();
@@ -2287,5 +4791,230 @@ namespace icfg{
       }
     };
 
+
+    /*****************************************************
+       Validator : checks the constraints of an already
+       bound result, as a pass of its own
+    ******************************************************/
+
+    template <size_t index, size_t size>
+    struct ConfigGroupValidator_t;
+
+    template <typename SwitchType, typename SettingName, typename... DefParams>
+    struct caseResultValidatorVisitor;
+
+    struct ConfigValueValidator_t{
+
+      //constraints of the definition itself, unless the error cap is reached
+      template <typename Definition, typename SettingResType>
+      static std::vector<ConfigError> checked(const Definition& definition, const SettingResType& setting, const LoadContext& context){
+        if (context.stopped()){
+          return std::vector<ConfigError>();
+        }
+        return context.reported(definition.validate(setting));
+      }
+      
+      //constraints of a group, but not of one a setting of which failed to bind
+      template <typename Definition, typename GroupResType>
+      static std::vector<ConfigError> checkedGroup(const Definition& definition, const GroupResType& group, const LoadContext& context){
+        if (BindingFailedIn(&group, context)){
+          return std::vector<ConfigError>();
+        }
+        return checked(definition, group, context);
+      }
+      
+      //constraints of the entries of a map, but those one setting of which failed to bind
+      template <typename MapDefinition, typename MapResType>
+      static std::vector<ConfigError> checkedMap(const MapDefinition& definition, const MapResType& setting, const LoadContext& context){
+        if (context.stopped()){
+          return std::vector<ConfigError>();
+        }
+        return context.reported(definition.validate(setting, [&context](const void* entry){ return BindingFailedIn(entry, context); }));
+      }
+      
+      //settings that failed to bind hold no value to check : their binding errors take their place, when the pass reports them
+      template <typename SettingResType>
+      static bool unbound(const SettingResType& setting, const LoadContext& context, std::vector<ConfigError>& errors){
+        if (context.record == nullptr){
+          return false;
+        }
+        auto failed = context.record->failedSettings.find(&setting);
+        if (failed == context.record->failedSettings.end()){
+          return false;
+        }
+        if (context.replayBindingErrors){
+          errors = failed->second;
+        }
+        return true;
+      }
+
+      //validate config
+      template<typename... DefParams, typename... ResParams>
+      static std::vector<ConfigError> validate(const configResult<ResParams...>& setting, const configDef<DefParams...>& definition, const LoadContext& context){
+        std::vector<ConfigError> errors = ConfigGroupValidator_t<0,groupResult<ResParams...>::size>::validate(definition.content, setting.result, context);
+        std::vector<ConfigError> groupErrors = checkedGroup(definition, setting, context);
+        errors.insert(errors.end(), groupErrors.begin(), groupErrors.end());
+        return errors;
+      }
+      
+      //validate setting
+      template <typename SettingResType, typename SettingName, typename... DefParams>
+      static std::vector<ConfigError> validate(const SettingResType& setting, const settingDef<SettingName, DefParams...>& definition, const LoadContext& context){
+        std::vector<ConfigError> bindingErrors;
+        if (unbound(setting, context, bindingErrors)){
+          return bindingErrors;
+        }
+        return WithinSetting(checked(definition, setting, context), SettingResType::myName::getString());
+      }
+      
+      //validate section
+      template<typename SettingName, typename... DefParams, typename... ResParams>
+      static std::vector<ConfigError> validate(const settingResult<SettingName, groupResult<ResParams...>>& setting, const sectionDef<DefParams...>& definition, const LoadContext& context){
+        std::vector<ConfigError> bindingErrors;
+        if (unbound(setting, context, bindingErrors)){
+          return bindingErrors;
+        }
+        std::vector<ConfigError> errors = ConfigGroupValidator_t<0,groupResult<ResParams...>::size>::validate(definition.content, setting.value, context);
+        std::vector<ConfigError> validationErrors = checkedGroup(definition, setting, context);
+        errors.insert(errors.end(), validationErrors.begin(), validationErrors.end());
+        return WithinSetting(errors, SettingName::getString());
+      }
+      
+      //validate map
+      template<typename SettingName, typename MapT, typename... DefParams>
+      static std::vector<ConfigError> validate(const settingResult<SettingName, MapT>& setting, const mapDef<DefParams...>& definition, const LoadContext& context){
+        typedef typename MapT::mapped_type group_type;
+        typedef typename MapT::value_type entry_type;
+        std::vector<ConfigError> errors;
+        if (unbound(setting, context, errors)){
+          return errors;
+        }
+        //entries are checked in the order they were bound in, which an unordered map doesn't keep
+        std::vector<const entry_type*> entries;
+        const std::vector<const void*>* order = nullptr;
+        if (context.record != nullptr){
+          auto recorded = context.record->entryOrders.find(&setting);
+          if (recorded != context.record->entryOrders.end()){
+            order = &recorded->second;
+          }
+        }
+        if (order != nullptr){
+          entries.reserve(order->size());
+          for (const void* entry : *order){
+            entries.push_back(static_cast<const entry_type*>(entry));
+          }
+        }
+        else {
+          entries.reserve(setting.value.size());
+          for (const auto& entry : setting.value){
+            entries.push_back(&entry);
+          }
+        }
+        if (context.pool != nullptr && entries.size() > 1){
+          //entries are independent : each is checked on its own, the errors then gathered in order ; nested maps are checked by the thread their entry is
+          LoadContext entryContext(context);
+          entryContext.pool = nullptr;
+          std::vector<std::vector<ConfigError>> entryErrors(entries.size());
+          ParallelFor(entries.size(), *context.pool, [&](std::size_t i){
+            entryErrors[i] = WithinSetting(ConfigGroupValidator_t<0,group_type::size>::validate(definition.content, entries[i]->second, entryContext), entries[i]->first);
+          });
+          for (std::size_t i = 0; i < entryErrors.size(); ++i){
+            errors.insert(errors.end(), entryErrors[i].begin(), entryErrors[i].end());
+          }
+        }
+        else {
+          for (const entry_type* entry : entries){
+            std::vector<ConfigError> entryErrors = WithinSetting(ConfigGroupValidator_t<0,group_type::size>::validate(definition.content, entry->second, context), entry->first);
+            errors.insert(errors.end(), entryErrors.begin(), entryErrors.end());
+          }
+        }
+        std::vector<ConfigError> validationErrors = checkedMap(definition, setting, context);
+        errors.insert(errors.end(), validationErrors.begin(), validationErrors.end());
+        return WithinSetting(errors, SettingName::getString());
+      }
+      
+      //validate switch : only the active case
+      template <typename SettingResType, typename SettingName, typename... DefParams>
+      static std::vector<ConfigError> validate(const SettingResType& setting, const switchDef<SettingName, DefParams...>& definition, const LoadContext& context){
+        std::vector<ConfigError> bindingErrors;
+        if (unbound(setting, context, bindingErrors)){
+          return bindingErrors;
+        }
+        caseResultValidatorVisitor<SettingResType, SettingName, DefParams...> visitor(setting, definition, context);
+        setting.visitCase(static_cast<std::string>(setting), visitor);
+        std::vector<ConfigError> validationErrors = WithinSetting(checked(definition, setting, context), SettingName::getString());
+        visitor.mErrors.insert(visitor.mErrors.end(), validationErrors.begin(), validationErrors.end());
+        return visitor.mErrors;
+      }
+      
+      //validate case
+      template <typename SettingResType, typename SettingName, typename... DefParams>
+      static std::vector<ConfigError> validate(const SettingResType& setting, const caseDef<SettingName, DefParams...>& definition, const LoadContext& context){
+        std::vector<ConfigError> errors = ConfigGroupValidator_t<0,decltype(setting.result)::size>::validate(definition.content, setting.result, context);
+        std::vector<ConfigError> groupErrors = checkedGroup(definition, setting, context);
+        errors.insert(errors.end(), groupErrors.begin(), groupErrors.end());
+        return errors;
+      }
+      
+      //optional settings hold no value to check
+      template <typename SettingResType, typename SettingName, typename... DefParams>
+      static std::vector<ConfigError> validate(const std::optional<SettingResType>&, const settingDef<SettingName, DefParams...>&, const LoadContext&){
+        return std::vector<ConfigError>();
+      }
+    };
+
+    template <typename ResultT, typename DefinitionT>
+    std::vector<ConfigError> ValidateBoundResult(const ResultT& result, const DefinitionT& definition, const LoadContext& context){
+      return ConfigValueValidator_t::validate(result, definition, context);
+    }
+
+    //iterates over a group of setting
+    template <size_t index, size_t size>
+    struct ConfigGroupValidator_t{
+
+      template <typename... DefParams, typename... ResParams>
+      static std::vector<ConfigError> validate(const std::tuple<DefParams...>& definition, const groupResult<ResParams...>& result, const LoadContext& context){
+        if (context.stopped()){
+          return std::vector<ConfigError>();
+        }
+        auto& resElm = result.template getNthSetting<index>();
+        const auto& defElm = std::get<ExtractSettingFromName<typename std::decay<decltype(resElm)>::type::myName, DefParams...>::index>(definition);
+        std::vector<ConfigError> errors = ConfigValueValidator_t::validate(resElm, defElm, context);
+        std::vector<ConfigError> nextErrors = ConfigGroupValidator_t<index+1,size>::validate(definition, result, context);
+        errors.insert(errors.end(), nextErrors.begin(), nextErrors.end());
+        return errors;
+      }
+    };
+
+    template <size_t index>
+    struct ConfigGroupValidator_t<index,index>{
+      template <typename... DefParams, typename... ResParams>
+      static std::vector<ConfigError> validate(const std::tuple<DefParams...>&, const groupResult<ResParams...>&, const LoadContext&){
+        return std::vector<ConfigError>();
+      }
+    };
+
+    template <typename SwitchType, typename SettingName, typename... DefParams>
+    struct caseResultValidatorVisitor{
+
+      const SwitchType& mSwitchRes;
+      const switchDef<SettingName, DefParams...>& mDefinition;
+      const LoadContext& mContext;
+      
+      std::vector<ConfigError> mErrors;
+
+      caseResultValidatorVisitor(const SwitchType& switchRes, const switchDef<SettingName, DefParams...>& definition, const LoadContext& context)
+      : mSwitchRes(switchRes)
+      , mDefinition(definition)
+      , mContext(context){}
+
+      template <typename Name>
+      void function(){
+        mErrors = ConfigValueValidator_t::validate(mSwitchRes.getCase(Name()), mDefinition.getCase(Name()), mContext);
+      }
+    };
+
   }
 }
+
+#endif //INSTANTCONFIG_H
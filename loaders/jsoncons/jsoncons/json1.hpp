@@ -222,7 +222,7 @@ public:
             : name_(pair.name_), value_(pair.value_)
         {
         }
-        member_type(member_type&& pair)
+        member_type(member_type&& pair) JSONCONS_NOEXCEPT
             //: name_(std::move(pair.name_)), value_(std::move(pair.value_))
         {
             name_.swap(pair.name_);
@@ -233,7 +233,7 @@ public:
         {
         }
         member_type(std::basic_string<Char>&& name, basic_json<Char,Alloc>&& value)
-            : name_(name), value_(value)
+            : name_(std::move(name)), value_(std::move(value))
         {
         }
 
@@ -925,7 +925,7 @@ public:
         void set(std::basic_string<Char>&& name, basic_json<Char,Alloc>&& value)
 
         {
-            val_.at(name_).set(name,value);
+            val_.at(name_).set(std::move(name),std::move(value));
         }
 
         template <typename T>
@@ -942,12 +942,12 @@ public:
 
         void add(basic_json<Char,Alloc>&& value)
         {
-            val_.at(name_).add(value);
+            val_.at(name_).add(std::move(value));
         }
 
         void add(size_t index, basic_json<Char,Alloc>&& value)
         {
-            val_.at(name_).add(index, value);
+            val_.at(name_).add(index, std::move(value));
         }
 
         void add(const basic_json<Char,Alloc>& value)
@@ -1124,7 +1124,7 @@ public:
 
     basic_json(const basic_json& val);
 
-    basic_json(basic_json&& val);
+    basic_json(basic_json&& val) JSONCONS_NOEXCEPT;
 
     explicit basic_json(any val);
 
@@ -1434,7 +1434,7 @@ public:
 
     void to_stream(basic_json_output_handler<Char>& handler) const;
 
-    void swap(basic_json<Char,Alloc>& b)
+    void swap(basic_json<Char,Alloc>& b) JSONCONS_NOEXCEPT
     {
         using std::swap;
 
@@ -1613,16 +1613,29 @@ private:
         return value_.string_value_;
     }
 
+    // String envelopes are allocated through Alloc, in units of string_data to keep them aligned
+    typedef typename Alloc::template rebind<string_data>::other string_allocator;
+
+    static size_t string_env_units(size_t length)
+    {
+        size_t size = sizeof(string_data) + (length+1)*sizeof(Char);
+        return (size + sizeof(string_data) - 1)/sizeof(string_data);
+    }
+
+    static char* allocate_string_env(size_t length)
+    {
+        return reinterpret_cast<char*>(string_allocator().allocate(string_env_units(length)));
+    }
+
     static void delete_string_env(const string_data* other)
     {
         //other->~string_data();
-        ::operator delete((void*)other);
+        string_allocator().deallocate(const_cast<string_data*>(other), string_env_units(other->length));
     }
 
     static string_data* create_string_env(const string_data* other)
     {
-        size_t size = sizeof(string_data) + (other->length+1)*sizeof(Char);
-        char* buffer = (char*)::operator new(size);
+        char* buffer = allocate_string_env(other->length);
         string_data* env = new(buffer)string_data;
         env->length = other->length;
         env->p = new(buffer+sizeof(string_data))Char[other->length+1];
@@ -1633,8 +1646,7 @@ private:
 
     static string_data* create_string_env(const std::basic_string<Char>& s)
     {
-        size_t size = sizeof(string_data) + (s.length()+1)*sizeof(Char);
-        char* buffer = (char*)::operator new(size);
+        char* buffer = allocate_string_env(s.length());
         string_data* env = new(buffer)string_data;
         env->length = s.length();
         env->p = new(buffer+sizeof(string_data))Char[s.length()+1];
@@ -1650,8 +1662,7 @@ private:
 
     static string_data* create_string_env(const Char* p, size_t length)
     {
-        size_t size = sizeof(string_data) + (length+1)*sizeof(Char);
-        char* buffer = (char*)::operator new(size);
+        char* buffer = allocate_string_env(length);
         string_data* env = new(buffer)string_data;
         env->length = length;
         env->p = new(buffer+sizeof(string_data))Char[length+1];
@@ -1662,8 +1673,7 @@ private:
 
     static string_data* create_string_env()
     {
-        size_t size = sizeof(string_data) + sizeof(Char);
-        char* buffer = (char*)::operator new(size);
+        char* buffer = allocate_string_env(0);
         string_data* env = new(buffer)string_data;
         env->length = 0;
         env->p = new(buffer+sizeof(string_data))Char[1];
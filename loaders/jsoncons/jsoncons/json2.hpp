@@ -678,7 +678,7 @@ void basic_json<Char, Alloc>::set(const std::basic_string<Char>& name, const bas
 }
 
 template<typename Char, typename Alloc>
-basic_json<Char, Alloc>::basic_json(basic_json&& other){
+basic_json<Char, Alloc>::basic_json(basic_json&& other) JSONCONS_NOEXCEPT {
     type_ = other.type_;
     value_ = other.value_;
     other.type_ = value_type::null_t;
@@ -688,7 +688,7 @@ template<typename Char, typename Alloc>
 void basic_json<Char, Alloc>::add(basic_json<Char, Alloc>&& value){
     switch (type_){
     case value_type::array_t:
-        value_.array_->push_back(value);
+        value_.array_->push_back(std::move(value));
         break;
     default:
         {
@@ -701,7 +701,7 @@ template<typename Char, typename Alloc>
 void basic_json<Char, Alloc>::add(size_t index, basic_json<Char, Alloc>&& value){
     switch (type_){
     case value_type::array_t:
-        value_.array_->add(index, value);
+        value_.array_->add(index, std::move(value));
         break;
     default:
         {
@@ -717,7 +717,7 @@ void basic_json<Char, Alloc>::set(std::basic_string<Char>&& name, basic_json<Cha
         type_ = value_type::object_t;
         value_.object_ = new json_object_impl<Char,Alloc>();
     case value_type::object_t:
-        value_.object_->set(name,value);
+        value_.object_->set(std::move(name),std::move(value));
         break;
     default:
         {
@@ -9,6 +9,7 @@
 #define JSONCONS_JSON_READER_HPP
 
 #include <memory>
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -148,7 +149,10 @@ public:
          err_handler_(std::addressof(err_handler)),
          bof_(true),
          eof_(false),
-         is_(std::addressof(is))
+         is_(std::addressof(is)),
+         input_(nullptr),
+         input_length_(0),
+         data_(nullptr)
     {
     }
     basic_json_reader(std::basic_istream<Char>& is,
@@ -167,7 +171,56 @@ public:
          err_handler_(std::addressof(default_basic_parse_error_handler<Char>::instance())),
          bof_(true),
          eof_(false),
-         is_(std::addressof(is))
+         is_(std::addressof(is)),
+         input_(nullptr),
+         input_length_(0),
+         data_(nullptr)
+    {
+    }
+
+    //  Parse JSON text held in a contiguous buffer, such as a memory mapped file, without copying it
+    basic_json_reader(const Char* input, size_t length,
+                      basic_json_input_handler<Char>& handler,
+                      basic_parse_error_handler<Char>& err_handler)
+       :
+         column_(0),
+         line_(0),
+         stack_(),
+         buffer_capacity_(0),
+         buffer_position_(0),
+         buffer_length_(0),
+         hard_buffer_length_(0),
+         estimation_buffer_length_(default_max_buffer_length),
+         handler_(std::addressof(handler)),
+         err_handler_(std::addressof(err_handler)),
+         bof_(true),
+         eof_(false),
+         is_(nullptr),
+         input_(input),
+         input_length_(length),
+         data_(nullptr)
+    {
+    }
+
+    basic_json_reader(const Char* input, size_t length,
+                      basic_json_input_handler<Char>& handler)
+       :
+         column_(0),
+         line_(0),
+         stack_(),
+         buffer_capacity_(0),
+         buffer_position_(0),
+         buffer_length_(0),
+         hard_buffer_length_(0),
+         estimation_buffer_length_(default_max_buffer_length),
+         handler_(std::addressof(handler)),
+         err_handler_(std::addressof(default_basic_parse_error_handler<Char>::instance())),
+         bof_(true),
+         eof_(false),
+         is_(nullptr),
+         input_(input),
+         input_length_(length),
+         data_(nullptr)
     {
     }
 
@@ -177,6 +230,10 @@ public:
 
     void read();
 
+    //  Reads the rest of the input, after the end of the document read() stopped at :
+    //  only whitespace and comments may follow it
+    void check_done();
+
     bool eof() const
     {
         return eof_;
@@ -224,6 +281,12 @@ private:
             extra = buffer_position_ - buffer_length_;
         }
 
+        if (is_ == nullptr)
+        {
+            read_some_in_place(extra);
+            return;
+        }
+
         buffer_position_ = 0;
         if (!is_->eof())
         {
@@ -282,6 +345,40 @@ private:
 
     }
 
+    // Contiguous input is parsed where it lies, up to its last read_ahead_length characters : 
+    // only those are copied, to the zero padded buffer_, so that looking ahead never reads past the input
+    void read_some_in_place(size_t extra)
+    {
+        if (bof_ && input_length_ > read_ahead_length)
+        {
+            bof_ = false;
+            data_ = input_;
+            buffer_position_ = 0;
+            buffer_length_ = input_length_ - read_ahead_length;
+            hard_buffer_length_ = input_length_;
+        }
+        else if (bof_ || data_ == input_)
+        {
+            const Char* tail = bof_ ? input_ : input_ + buffer_length_ + extra;
+            size_t unread = bof_ ? input_length_ : read_ahead_length - extra;
+            bof_ = false;
+            std::fill(buffer_.begin(), buffer_.end(), Char());
+            std::copy(tail, tail + unread, buffer_.begin());
+            data_ = &buffer_[0];
+            buffer_position_ = 0;
+            buffer_length_ = unread;
+            hard_buffer_length_ = unread;
+            eof_ = unread == 0;
+        }
+        else
+        {
+            buffer_position_ = 0;
+            buffer_length_ = 0;
+            hard_buffer_length_ = 0;
+            eof_ = true;
+        }
+    }
+
     unsigned long do_line_number() const override
     {
         return line_;
@@ -294,7 +391,7 @@ private:
 
     //Char do_peek() const override
     //{
-       // return buffer_[buffer_position_];
+       // return data_[buffer_position_];
     //}
 
     bool do_eof() const override
@@ -327,6 +424,10 @@ private:
     bool bof_;
     bool eof_;
     std::basic_istream<Char> *is_;
+    const Char* input_;
+    size_t input_length_;
+    // Characters being parsed : buffer_, or input_ when reading in place
+    const Char* data_;
     Char c_;
 };
 
@@ -382,11 +483,12 @@ long long string_to_integer(bool has_neg, const Char *s, size_t length) throw(st
 template<typename Char>
 void basic_json_reader<Char>::read()
 {
-    if (is_->bad())
+    if (is_ != nullptr && is_->bad())
     {
         JSONCONS_THROW_EXCEPTION("Input stream is invalid");
     }
     buffer_.resize(buffer_capacity_ + 2 * read_ahead_length);
+    data_ = &buffer_[0];
     buffer_position_ = 0;
     buffer_length_ = 0;
     hard_buffer_length_ = 0;
@@ -409,6 +511,64 @@ void basic_json_reader<Char>::read()
     }
 }
 
+template<typename Char>
+void basic_json_reader<Char>::check_done()
+{
+    while (!eof())
+    {
+        while (buffer_position_ < buffer_length_)
+        {
+            c_ = data_[buffer_position_++];
+            ++column_;
+            switch (c_)
+            {
+            case '\r':
+                ++line_;
+                column_ = 0;
+                if (data_[buffer_position_] == '\n')
+                {
+                    ++buffer_position_;
+                }
+                break;
+            case '\n':
+                ++line_;
+                column_ = 0;
+                break;
+            case '\t':
+            case '\v':
+            case '\f':
+            case ' ':
+                break;
+            case '/':
+                {
+                    Char next = data_[buffer_position_];
+                    if (next == '/')
+                    {
+                        ++buffer_position_;
+                        ignore_single_line_comment();
+                        break;
+                    }
+                    else if (next == '*')
+                    {
+                        ++buffer_position_;
+                        ignore_multi_line_comment();
+                        break;
+                    }
+                }
+                err_handler_->error(std::error_code(json_parser_errc::extra_character, json_parser_category()), *this);
+                break;
+            default:
+                err_handler_->error(std::error_code(json_parser_errc::extra_character, json_parser_category()), *this);
+                break;
+            }
+        }
+        if (buffer_position_ >= buffer_length_)
+        {
+            read_some();
+        }
+    }
+}
+
 template<typename Char>
 void basic_json_reader<Char>::parse()
 {
@@ -416,7 +576,7 @@ void basic_json_reader<Char>::parse()
     {
         while (buffer_position_ < buffer_length_)
         {
-            c_ = buffer_[buffer_position_++];
+            c_ = data_[buffer_position_++];
             ++column_;
             switch (c_)
             {
@@ -424,7 +584,7 @@ void basic_json_reader<Char>::parse()
             case '\r':
                 ++line_;
                 column_ = 0;
-                if (buffer_[buffer_position_] == '\n')
+                if (data_[buffer_position_] == '\n')
                 {
                     ++buffer_position_;
                 }
@@ -441,7 +601,7 @@ void basic_json_reader<Char>::parse()
             // Skip comments
             case '/':
                 {
-                    Char next = buffer_[buffer_position_];
+                    Char next = data_[buffer_position_];
                     if (next == '/')
                     {
                         ++buffer_position_;
@@ -587,7 +747,7 @@ void basic_json_reader<Char>::parse()
                         err_handler_->error(std::error_code(err, json_parser_category()), *this);
                     }
                 
-                    if (!((buffer_[buffer_position_] == 'r') & (buffer_[buffer_position_ + 1] == 'u') & (buffer_[buffer_position_ + 2] == 'e')))
+                    if (!((data_[buffer_position_] == 'r') & (data_[buffer_position_ + 1] == 'u') & (data_[buffer_position_ + 2] == 'e')))
                     {
                         err_handler_->error(std::error_code(json_parser_errc::expected_value, json_parser_category()), *this);
                     }
@@ -605,7 +765,7 @@ void basic_json_reader<Char>::parse()
                         err_handler_->error(std::error_code(err, json_parser_category()), *this);
                     }
                 }
-                if (!((buffer_[buffer_position_] == 'a') & (buffer_[buffer_position_ + 1] == 'l') & (buffer_[buffer_position_ + 2] == 's') & (buffer_[buffer_position_ + 3] == 'e')))
+                if (!((data_[buffer_position_] == 'a') & (data_[buffer_position_ + 1] == 'l') & (data_[buffer_position_ + 2] == 's') & (data_[buffer_position_ + 3] == 'e')))
                 {
                     err_handler_->error(std::error_code(json_parser_errc::expected_value, json_parser_category()), *this);
                 }
@@ -622,7 +782,7 @@ void basic_json_reader<Char>::parse()
                         err_handler_->error(std::error_code(err, json_parser_category()), *this);
                     }
                 }
-                if (!((buffer_[buffer_position_] == 'u') & (buffer_[buffer_position_ + 1] == 'l') & (buffer_[buffer_position_ + 2] == 'l')))
+                if (!((data_[buffer_position_] == 'u') & (data_[buffer_position_ + 1] == 'l') & (data_[buffer_position_ + 2] == 'l')))
                 {
                     err_handler_->error(std::error_code(json_parser_errc::expected_value, json_parser_category()), *this);
                 }
@@ -715,7 +875,7 @@ void basic_json_reader<Char>::parse_number()
         const size_t end = buffer_length_;
         while (!done & (buffer_position_ < end))
         {
-            c_ = buffer_[buffer_position_]; // shouldn't be lf
+            c_ = data_[buffer_position_]; // shouldn't be lf
             switch (c_)
             {
             case '0':
@@ -887,7 +1047,7 @@ void basic_json_reader<Char>::parse_string()
         const size_t end = buffer_length_;
         while (!done & (buffer_position_ < end))
         {
-            c_ = buffer_[buffer_position_++];
+            c_ = data_[buffer_position_++];
             ++column_;
             switch (c_)
             {
@@ -927,7 +1087,7 @@ void basic_json_reader<Char>::parse_string()
                 break;
             case '\\':
                 {
-                    Char next = buffer_[buffer_position_];
+                    Char next = data_[buffer_position_];
                     switch (next)
                     {
                     case '\"':
@@ -1002,12 +1162,12 @@ void basic_json_reader<Char>::ignore_single_line_comment()
         const size_t end = buffer_length_;
         while (!done & (buffer_position_ < end))
         {
-            c_ = buffer_[buffer_position_++];
+            c_ = data_[buffer_position_++];
             ++column_;
             switch (c_)
             {
             case '\r':
-                if (buffer_[buffer_position_] == '\n')
+                if (data_[buffer_position_] == '\n')
                 {
                     ++buffer_position_;
                 }
@@ -1042,12 +1202,12 @@ void basic_json_reader<Char>::ignore_multi_line_comment()
         const size_t end = buffer_length_;
         while (!done & (buffer_position_ < end))
         {
-            c_ = buffer_[buffer_position_++];
+            c_ = data_[buffer_position_++];
             ++column_;
             switch (c_)
             {
             case '\r':
-                if (buffer_[buffer_position_] == '\n')
+                if (data_[buffer_position_] == '\n')
                 {
                     ++buffer_position_;
                 }
@@ -1060,7 +1220,7 @@ void basic_json_reader<Char>::ignore_multi_line_comment()
                 break;
             case '*':
                 {
-                    Char next = buffer_[buffer_position_];
+                    Char next = data_[buffer_position_];
                     if (next == '/')
                     {
                         done = true;
@@ -1088,10 +1248,10 @@ size_t basic_json_reader<Char>::estimate_minimum_array_capacity() const
     size_t size = 0;
     size_t pos = buffer_position_;
     bool done = false;
-    const size_t end = std::min JSONCONS_NO_MACRO_EXP(buffer_length_, estimation_buffer_length_);
+    const size_t end = std::min JSONCONS_NO_MACRO_EXP(buffer_length_, buffer_position_ + estimation_buffer_length_);
     while (!done & (pos < end))
     {
-        switch (buffer_[pos])
+        switch (data_[pos])
         {
         case end_array:
             done = true;
@@ -1149,10 +1309,10 @@ size_t basic_json_reader<Char>::estimate_minimum_object_capacity() const
     size_t size = 0;
     size_t pos = buffer_position_;
     bool done = false;
-    const size_t end = std::min JSONCONS_NO_MACRO_EXP(buffer_length_, estimation_buffer_length_);
+    const size_t end = std::min JSONCONS_NO_MACRO_EXP(buffer_length_, buffer_position_ + estimation_buffer_length_);
     while (!done & (pos < end))
     {
-        switch (buffer_[pos])
+        switch (data_[pos])
         {
         case end_object:
             done = true;
@@ -1194,7 +1354,7 @@ size_t basic_json_reader<Char>::skip_array(size_t pos, const size_t end) const
     bool done = false;
     while (!done & (pos < end))
     {
-        switch (buffer_[pos])
+        switch (data_[pos])
         {
         case begin_array:
             pos = skip_array(pos + 1, end);
@@ -1224,11 +1384,11 @@ size_t basic_json_reader<Char>::skip_string(size_t pos, const size_t end) const
     bool done = false;
     while (!done & (pos < end))
     {
-        switch (buffer_[pos])
+        switch (data_[pos])
         {
         case '\\':
             ++pos;
-            if ((pos < buffer_length_) & (buffer_[pos] == 'u'))
+            if ((pos < buffer_length_) & (data_[pos] == 'u'))
             {
                 pos += 4;
             }
@@ -1256,7 +1416,7 @@ size_t basic_json_reader<Char>::skip_number(size_t pos, const size_t end) const
     bool done = false;
     while (!done & (pos < end))
     {
-        switch (buffer_[pos])
+        switch (data_[pos])
         {
         case '0':
         case '1':
@@ -1290,7 +1450,7 @@ size_t basic_json_reader<Char>::skip_object(size_t pos, const size_t end) const
     bool done = false;
     while (!done & (pos < end))
     {
-        switch (buffer_[pos])
+        switch (data_[pos])
         {
         case begin_object:
             pos = skip_object(pos + 1, end);
@@ -1325,7 +1485,7 @@ uint32_t basic_json_reader<Char>::decode_unicode_codepoint()
     if (cp >= min_lead_surrogate && cp <= max_lead_surrogate)
     {
         // surrogate pair
-        if (buffer_[buffer_position_++] == '\\' && buffer_[buffer_position_++] == 'u')
+        if (data_[buffer_position_++] == '\\' && data_[buffer_position_++] == 'u')
         {
             column_ += 2;
             uint32_t surrogate_pair = decode_unicode_escape_sequence();
@@ -1351,7 +1511,7 @@ uint32_t basic_json_reader<Char>::decode_unicode_escape_sequence()
     size_t index = 0;
     while (index < 4)
     {
-        c_ = buffer_[buffer_position_++];
+        c_ = data_[buffer_position_++];
         ++column_;
         const uint32_t u(c_ >= 0 ? c_ : 256 + c_);
         cp *= 16;
@@ -23,6 +23,15 @@
 
 namespace jsoncons {
 
+// Storage of arrays and objects, allocated through Alloc like the rest of the tree
+template <typename Char,class Alloc>
+struct json_storage
+{
+    typedef std::pair<std::basic_string<Char>,basic_json<Char,Alloc>> member_type;
+    typedef std::vector<basic_json<Char,Alloc>,typename Alloc::template rebind<basic_json<Char,Alloc>>::other> elements_type;
+    typedef std::vector<member_type,typename Alloc::template rebind<member_type>::other> members_type;
+};
+
 template <typename Char,class Alloc>
 class key_compare
 {
@@ -49,8 +58,9 @@ template <typename Char,class Alloc>
 class json_array_impl 
 {
 public:
-    typedef typename std::vector<basic_json<Char,Alloc>>::iterator iterator;
-    typedef typename std::vector<basic_json<Char,Alloc>>::const_iterator const_iterator;
+    typedef typename json_storage<Char,Alloc>::elements_type elements_type;
+    typedef typename elements_type::iterator iterator;
+    typedef typename elements_type::const_iterator const_iterator;
 
     // Allocation
     static void* operator new(std::size_t) { return typename Alloc::template rebind<json_array_impl>::other().allocate(1); }
@@ -70,8 +80,8 @@ public:
     {
     }
 
-    json_array_impl(std::vector<basic_json<Char,Alloc>> elements)
-        : elements_(elements)
+    json_array_impl(elements_type elements)
+        : elements_(std::move(elements))
     {
     }
 
@@ -122,13 +132,13 @@ public:
 
     void push_back(basic_json<Char,Alloc>&& value)
     {
-        elements_.push_back(value);
+        elements_.push_back(std::move(value));
     }
 
     void add(size_t index, basic_json<Char,Alloc>&& value)
     {
         json_array_impl<Char,Alloc>::iterator position = index < elements_.size() ? elements_.begin() + index : elements_.end();
-        elements_.insert(position, value);
+        elements_.insert(position, std::move(value));
     }
 
     iterator begin() {return elements_.begin();}
@@ -160,7 +170,7 @@ public:
     {
     }
 private:
-    std::vector<basic_json<Char,Alloc>> elements_;
+    elements_type elements_;
     json_array_impl& operator=(const json_array_impl<Char,Alloc>&);
 };
 
@@ -172,7 +182,7 @@ class object_iterator
     typedef typename std::conditional<IsConst, const typename basic_json<Char,Alloc>::member_type*, typename basic_json<Char,Alloc>::member_type*>::type pointer;
     typedef typename std::conditional<IsConst, const typename basic_json<Char,Alloc>::member_type&, typename basic_json<Char,Alloc>::member_type&>::type reference;
     typedef std::bidirectional_iterator_tag  iterator_category;
-    typedef typename std::vector<std::pair<std::basic_string<Char>,basic_json<Char,Alloc>>>::iterator iterator_impl;
+    typedef typename json_storage<Char,Alloc>::members_type::iterator iterator_impl;
     class deref_proxy;
     friend class deref_proxy;
 
@@ -299,8 +309,9 @@ public:
     typedef object_iterator<Char,Alloc,false> iterator;
     typedef object_iterator<Char,Alloc,true> const_iterator;
 	typedef std::pair<std::basic_string<Char>,basic_json<Char,Alloc>> member_type;
-    typedef typename std::vector<member_type>::iterator internal_iterator;
-    typedef typename std::vector<member_type>::const_iterator const_internal_iterator;
+    typedef typename json_storage<Char,Alloc>::members_type members_type;
+    typedef typename members_type::iterator internal_iterator;
+    typedef typename members_type::const_iterator const_internal_iterator;
 
     // Allocation
     static void* operator new(std::size_t) { return typename Alloc::template rebind<json_object_impl>::other().allocate(1); }
@@ -315,8 +326,8 @@ public:
     {
     }
 
-    json_object_impl(std::vector<member_type> members)
-        : members_(members)
+    json_object_impl(members_type members)
+        : members_(std::move(members))
     {
     }
 
@@ -389,23 +400,20 @@ public:
 
     void set(std::basic_string<Char>&& name, basic_json<Char,Alloc>&& value)
     {
-        auto it = std::lower_bound(begin(),end(),name ,key_compare<Char,Alloc>());
-        if (it != end() && it->name() == name)
+        auto it = std::lower_bound(members_.begin(),members_.end(),name ,key_compare<Char,Alloc>());
+        if (it != members_.end() && it->first == name)
         {
-            *it = member_type(name,value);
+            it->second.swap(value);
         }
         else
         {
-            insert(it,member_type(name,value));
+            members_.insert(it,member_type(std::move(name),std::move(value)));
         }
     }
 
     void push_back(std::basic_string<Char>&& name, basic_json<Char,Alloc>&& val)
     {
-        members_.push_back(member_type());
-        members_.back().first.swap(name);
-        members_.back().second.swap(val);
-        //members_.push_back(typename basic_json<Char,Alloc>::member_type(name,val)); // much slower on VS 2010
+        members_.emplace_back(std::move(name),std::move(val));
     }
 
     basic_json<Char,Alloc>& get(const std::basic_string<Char>& name) 
@@ -467,7 +475,7 @@ public:
 
 private:
 
-    std::vector<member_type> members_;
+    members_type members_;
     json_object_impl<Char,Alloc>& operator=(const json_object_impl<Char,Alloc>&);
 };
 
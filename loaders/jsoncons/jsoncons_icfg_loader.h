@@ -3,172 +3,1130 @@
 
 #include "jsoncons/json.hpp"
 
+#include "../../instantConfig.h"
+
 #include <iterator>
 #include <fstream>
+#include <limits>
+#include <new>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cerrno>
+#include <mutex>
 
-namespace icfg{
-
-  class jsoncons_loader{
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define ICFG_JSONCONS_MMAP
+#endif
 
-  public:
-    typedef jsoncons::json ValueType;
+namespace icfg{
 
+  /*
+    Monotonic arena backing the DOM of an arena_jsoncons_loader : nodes are
+    carved out of large blocks, released all at once with the arena
+  */
+  class json_arena{
+  
   public:
-    //throws jsoncons::json_parse_exception on error
-    jsoncons_loader(const std::string& fileName){
-    
-      mRoot = jsoncons::json::parse_file(fileName);
-      
+    json_arena()
+    : mBlocks()
+    , mCursor(nullptr)
+    , mRemaining(0)
+    , mNextBlockSize(sFirstBlockSize){
+      std::lock_guard<std::mutex> lock(registryMutex());
+      registry().push_back(this);
     }
     
-    const ValueType& getRoot() const {
-      return mRoot;
+    json_arena(json_arena&& other)
+    : mBlocks()
+    , mCursor(other.mCursor)
+    , mRemaining(other.mRemaining)
+    , mNextBlockSize(other.mNextBlockSize){
+      std::lock_guard<std::mutex> lock(registryMutex());
+      mBlocks.swap(other.mBlocks);
+      other.mCursor = nullptr;
+      other.mRemaining = 0;
+      registry().push_back(this);
     }
     
-    bool hasValue(const ValueType& from, const std::string& settingName) const {
-      return from.has_member(settingName);
+    ~json_arena(){
+      {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        std::vector<json_arena*>& arenas = registry();
+        arenas.erase(std::find(arenas.begin(), arenas.end(), this));
+      }
+      for (std::size_t i = 0; i < mBlocks.size(); ++i){
+        ::operator delete(mBlocks[i].first);
+      }
     }
     
-    std::vector<std::string> getContainedValues(const ValueType& from) const{
-      std::vector<std::string> lMembers;
-      
-      if (from.is<jsoncons::json::object>()){
-        std::for_each(from.begin_members(), from.end_members(), [&lMembers](const jsoncons::json::member_type& val){lMembers.push_back(val.name());});
+    void* allocate(std::size_t size, std::size_t alignment){
+      std::size_t padding = (alignment - reinterpret_cast<std::uintptr_t>(mCursor) % alignment) % alignment;
+      if (padding + size > mRemaining){
+        grow(size + alignment);
+        padding = (alignment - reinterpret_cast<std::uintptr_t>(mCursor) % alignment) % alignment;
       }
-      
-      return lMembers;
+      void* result = mCursor + padding;
+      mCursor += padding + size;
+      mRemaining -= padding + size;
+      return result;
     }
     
-    const ValueType& getContainedValue(const ValueType& from, const std::string& name) const{
-      return from[name];
+    //whether the memory at pointer was carved out of this arena
+    bool owns(const void* pointer) const {
+      const char* address = static_cast<const char*>(pointer);
+      //last block starting at or before the address
+      auto block = std::upper_bound(mBlocks.begin(), mBlocks.end(), address, 
+        [](const char* a, const std::pair<char*, std::size_t>& b){ return a < b.first; });
+      if (block == mBlocks.begin()){
+        return false;
+      }
+      --block;
+      return address < block->first + block->second;
     }
-
-    template <typename SettingType>
-    void getValue(const ValueType& parent, const std::string& name, SettingType& dest) const {
-      const jsoncons::json& from = parent[name];
-      
-      if (from.is_null()) {
-        throw std::string("missing value : " + name);
+    
+    //whether the memory at pointer was carved out of any live arena
+    static bool anyOwns(const void* pointer){
+      std::lock_guard<std::mutex> lock(registryMutex());
+      const std::vector<json_arena*>& arenas = registry();
+      for (std::size_t i = 0; i < arenas.size(); ++i){
+        if (arenas[i]->owns(pointer)){
+          return true;
+        }
       }
-
-      extract(from, name, dest);
+      return false;
     }
     
-    void extract(const ValueType& from, const std::string& name, std::string& dest) const {
-
-      if (!from.is_string()){
-        throw std::string("value "+name+" is expected to be a string");
+    //arena the DOM of the current thread is being built into
+    static json_arena*& current(){
+      static thread_local json_arena* sCurrent = nullptr;
+      return sCurrent;
+    }
+    
+    //makes an arena current for the lifetime of the scope
+    class scope{
+    
+    public:
+      explicit scope(json_arena& arena)
+      : mPrevious(current()){
+        current() = &arena;
+      }
+      
+      ~scope(){
+        current() = mPrevious;
       }
       
-      dest = from.as_string();
+    private:
+      scope(const scope&);
+      scope& operator=(const scope&);
+      
+      json_arena* mPrevious;
+    };
+    
+  private:
+    json_arena(const json_arena&);
+    json_arena& operator=(const json_arena&);
+    
+    //arenas alive in the process, searched when a node is freed outside of its own arena
+    static std::vector<json_arena*>& registry(){
+      static std::vector<json_arena*> sArenas;
+      return sArenas;
     }
     
-    void extract(const ValueType& from, const std::string& name, int8_t& dest) const {
-
-      if (!from.is<short>()){
-        throw std::string("value "+name+" is expected to be a int8_t");
+    static std::mutex& registryMutex(){
+      static std::mutex sMutex;
+      return sMutex;
+    }
+    
+    void grow(std::size_t minimumSize){
+      std::size_t blockSize = minimumSize > mNextBlockSize ? minimumSize : mNextBlockSize;
+      char* block = static_cast<char*>(::operator new(blockSize));
+      {
+        //blocks are kept sorted by address for owns()
+        std::lock_guard<std::mutex> lock(registryMutex());
+        std::pair<char*, std::size_t> entry(block, blockSize);
+        mBlocks.insert(std::upper_bound(mBlocks.begin(), mBlocks.end(), entry), entry);
       }
-      
-      dest = static_cast<int8_t>(from.as<short>());
+      mCursor = block;
+      mRemaining = blockSize;
+      mNextBlockSize = mNextBlockSize < sMaxBlockSize ? mNextBlockSize * 2 : mNextBlockSize;
     }
     
-    void extract(const ValueType& from, const std::string& name, uint8_t& dest) const {
-
-      if (!from.is<unsigned short>()){
-        throw std::string("value "+name+" is expected to be a uint8_t");
+    static const std::size_t sFirstBlockSize = 64 * 1024;
+    static const std::size_t sMaxBlockSize = 4 * 1024 * 1024;
+    
+    //start and size of each block, by address
+    std::vector<std::pair<char*, std::size_t> > mBlocks;
+    char* mCursor;
+    std::size_t mRemaining;
+    std::size_t mNextBlockSize;
+  };
+  
+  /*
+    Stateless allocator drawing from the current json_arena, as jsoncons
+    default-constructs its allocators. Without a current arena (jsoncons'
+    static values), it falls back to the heap. Freeing a node checks where it
+    comes from : arena memory goes back with its arena, whichever is current,
+    and heap memory is deleted.
+  */
+  template <typename T>
+  class arena_allocator{
+  
+  public:
+    typedef T value_type;
+    
+    template <typename U>
+    struct rebind{
+      typedef arena_allocator<U> other;
+    };
+    
+    arena_allocator(){}
+    
+    template <typename U>
+    arena_allocator(const arena_allocator<U>&){}
+    
+    T* allocate(std::size_t n){
+      json_arena* arena = json_arena::current();
+      if (arena == nullptr){
+        return static_cast<T*>(::operator new(n * sizeof(T)));
       }
-      
-      dest = static_cast<uint8_t>(from.as<unsigned short>());
+      return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
     }
     
-    void extract(const ValueType& from, const std::string& name, float& dest) const {
-
-      if (!from.is<double>()){
-        throw std::string("value "+name+" is expected to be a float");
+    void deallocate(T* pointer, std::size_t){
+      json_arena* arena = json_arena::current();
+      //the DOM of the current arena is the common case, and needs no lock
+      if (arena != nullptr && arena->owns(pointer)){
+        return;
+      }
+      if (!json_arena::anyOwns(pointer)){
+        ::operator delete(pointer);
       }
-      
-      dest = static_cast<float>(from.as<double>());
     }
+  };
+  
+  template <typename T, typename U>
+  bool operator==(const arena_allocator<T>&, const arena_allocator<U>&){
+    return true;
+  }
+  
+  template <typename T, typename U>
+  bool operator!=(const arena_allocator<T>&, const arena_allocator<U>&){
+    return false;
+  }
+  
+  namespace internal{
+  
+    //read-only view over the whole content of a file, memory mapped where the platform allows it
+    class MappedFile{
     
-    template <typename SettingType>
-    void extract(const ValueType& from, const std::string& name, SettingType& dest) const {
+    public:
+      explicit MappedFile(const std::string& fileName)
+      : mData(nullptr)
+      , mLength(0)
+      , mMapped(false)
+      , mContent(){
       
-      if (!from.is<SettingType>()) {
-        throw std::string("value " + name + " is expected to be a "+getTypeName<SettingType>());
+#ifdef ICFG_JSONCONS_MMAP
+        int descriptor = ::open(fileName.c_str(), O_RDONLY);
+        if (descriptor < 0){
+          throw std::string("couldn't open config file " + fileName);
+        }
+        map(descriptor);
+        ::close(descriptor);
+        if (mMapped){
+          return;
+        }
+#endif
+        //no mapping : the file is read in a single block
+        std::ifstream file(fileName.c_str(), std::ifstream::in | std::ifstream::binary);
+        if (!file.is_open()){
+          throw std::string("couldn't open config file " + fileName);
+        }
+        mContent.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        mData = mContent.data();
+        mLength = mContent.size();
       }
-
-      dest = static_cast<SettingType>(from.as<SettingType>());
-    }
+      
+#ifdef ICFG_JSONCONS_MMAP
+      //regular files not read from yet are mapped, anything else (pipes, sockets) is read until its end
+      explicit MappedFile(const file_descriptor& descriptor)
+      : mData(nullptr)
+      , mLength(0)
+      , mMapped(false)
+      , mContent(){
+      
+        if (::lseek(descriptor.get(), 0, SEEK_CUR) <= 0){
+          map(descriptor.get());
+        }
+        if (mMapped){
+          return;
+        }
+        
+        char block[65536];
+        for (;;){
+          ssize_t count = ::read(descriptor.get(), block, sizeof(block));
+          if (count < 0 && errno == EINTR){
+            continue;
+          }
+          if (count < 0){
+            throw std::string("couldn't read config from " + descriptor.name());
+          }
+          if (count == 0){
+            break;
+          }
+          mContent.append(block, static_cast<std::size_t>(count));
+        }
+        mData = mContent.data();
+        mLength = mContent.size();
+      }
+#endif
+      
+      ~MappedFile(){
+#ifdef ICFG_JSONCONS_MMAP
+        if (mMapped){
+          ::munmap(const_cast<char*>(mData), mLength);
+        }
+#endif
+      }
+      
+      const char* data() const {
+        return mData;
+      }
+      
+      std::size_t size() const {
+        return mLength;
+      }
+      
+    private:
+      MappedFile(const MappedFile&);
+      MappedFile& operator=(const MappedFile&);
+      
+#ifdef ICFG_JSONCONS_MMAP
+      void map(int descriptor){
+        struct stat info;
+        if (::fstat(descriptor, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0){
+          void* address = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+          if (address != MAP_FAILED){
+            ::madvise(address, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+            mData = static_cast<const char*>(address);
+            mLength = static_cast<std::size_t>(info.st_size);
+            mMapped = true;
+          }
+        }
+      }
+#endif
+      
+      const char* mData;
+      std::size_t mLength;
+      bool mMapped;
+      std::string mContent;
+    };
+  
+    //memory the DOM of a loader is built into : the default allocators need none
+    template <typename Alloc>
+    struct JsonconsDomMemory{
+    
+      struct scope{
+        explicit scope(JsonconsDomMemory&){}
+      };
+    };
+    
+    template <typename T>
+    struct JsonconsDomMemory<arena_allocator<T> >{
     
-    template <typename ValueT>
-    void extract(const ValueType& from, const std::string& name, std::vector<ValueT>& dest) const {
+      typedef json_arena::scope scope;
       
-      if (!from.is_array()) {
-        throw std::string("value " + name + " is expected to be an array");
+      operator json_arena&(){
+        return arena;
       }
       
-      std::size_t ind;
-      std:for_each(from.begin_elements(), from.end_elements(), 
-      [&](const jsoncons::json& elm){
-        ValueT outputValue;
-        this->extract(elm, name + "[" + std::to_string(ind) + "]", outputValue);
-        dest.push_back(outputValue);
-        ++ind;
-      });
-    }
+      json_arena arena;
+    };
     
-  private:
     template <typename SettingType>
-    std::string getTypeName() const{
+    inline std::string jsonconsTypeName(){
       return "'unknown type'";
     }
     
-  private:
-    jsoncons::json mRoot;
-
-  };
-  
-  
     template <>
-    std::string jsoncons_loader::getTypeName<bool>() const{
+    inline std::string jsonconsTypeName<bool>(){
       return "bool";
     }
     
     template <>
-    std::string jsoncons_loader::getTypeName<int16_t>() const{
+    inline std::string jsonconsTypeName<int16_t>(){
       return "int16_t";
     }
     
     template <>
-    std::string jsoncons_loader::getTypeName<uint16_t>() const{
+    inline std::string jsonconsTypeName<uint16_t>(){
       return "uint16_t";
     }
     
     template <>
-    std::string jsoncons_loader::getTypeName<int32_t>() const{
+    inline std::string jsonconsTypeName<int32_t>(){
       return "int32_t";
     }
     
     template <>
-    std::string jsoncons_loader::getTypeName<uint32_t>() const{
+    inline std::string jsonconsTypeName<uint32_t>(){
       return "uint32_t";
     }
     
     template <>
-    std::string jsoncons_loader::getTypeName<int64_t>() const{
+    inline std::string jsonconsTypeName<int64_t>(){
       return "int64_t";
     }
     
     template <>
-    std::string jsoncons_loader::getTypeName<uint64_t>() const{
+    inline std::string jsonconsTypeName<uint64_t>(){
       return "uint64_t";
     }
     
     template <>
-    std::string jsoncons_loader::getTypeName<double>() const{
+    inline std::string jsonconsTypeName<double>(){
       return "double";
     }
     
+  }
+
+  /*
+    Dotted path of the single section a loader is restricted to, 
+    e.g. subtree("Graphics.Resolution")
+  */
+  class subtree{
+  
+  public:
+    explicit subtree(const std::string& path)
+    : mPath(path)
+    , mNames(){
+      std::string::size_type begin = 0;
+      while (begin <= path.size() && !path.empty()){
+        std::string::size_type end = path.find('.', begin);
+        if (end == std::string::npos){
+          end = path.size();
+        }
+        mNames.push_back(path.substr(begin, end - begin));
+        begin = end + 1;
+      }
+    }
+    
+    const std::string& str() const {
+      return mPath;
+    }
+    
+    const std::vector<std::string>& names() const {
+      return mNames;
+    }
+    
+  private:
+    std::string mPath;
+    std::vector<std::string> mNames;
+  };
+  
+  namespace internal{
+  
+    /*
+      Forwards to the deserializer only the events of the object found at
+      the given path : everything else is skipped as it is read, without
+      being materialized
+    */
+    template <typename Char>
+    class SubtreeFilter : public jsoncons::basic_json_input_handler<Char>{
+    
+    public:
+      //thrown once the subtree is complete, to stop reading the rest of the document
+      struct complete{};
+      
+      SubtreeFilter(const subtree& path, jsoncons::basic_json_input_handler<Char>& target)
+      : mPath(path)
+      , mTarget(target)
+      , mDepth(0)
+      , mMatched(0)
+      , mNameMatches(false)
+      , mTargetDepth(0)
+      , mFound(false){}
+      
+      bool found() const {
+        return mFound;
+      }
+      
+    private:
+      typedef jsoncons::basic_parsing_context<Char> context_type;
+      
+      bool forwarding() const {
+        return mTargetDepth != 0;
+      }
+      
+      //the value about to be read is on the path : the root or a member named after the next path element
+      bool valueOnPath() const {
+        return mDepth == 0 || (mDepth == mMatched && mNameMatches);
+      }
+      
+      bool valueIsTarget() const {
+        return valueOnPath() && mMatched == mPath.names().size();
+      }
+      
+      void skipValue(){
+        if (valueIsTarget()){
+          throw std::string("subtree " + mPath.str() + " is expected to be an object");
+        }
+        mNameMatches = false;
+      }
+      
+      void do_begin_json() override {}
+      
+      void do_end_json() override {}
+      
+      void do_begin_object(const context_type& context) override {
+        if (forwarding()){
+          ++mDepth;
+          mTarget.begin_object(context);
+          return;
+        }
+        
+        const bool onPath = valueOnPath();
+        ++mDepth;
+        mNameMatches = false;
+        if (onPath){
+          ++mMatched;
+          if (mMatched == mPath.names().size() + 1){
+            mFound = true;
+            mTargetDepth = mDepth;
+            mTarget.begin_object(context);
+          }
+        }
+      }
+      
+      void do_end_object(const context_type& context) override {
+        if (forwarding()){
+          mTarget.end_object(context);
+          if (--mDepth < mTargetDepth){
+            throw complete();
+          }
+          return;
+        }
+        
+        --mDepth;
+        if (mMatched > mDepth){
+          mMatched = mDepth;
+        }
+        mNameMatches = false;
+      }
+      
+      void do_begin_array(const context_type& context) override {
+        if (forwarding()){
+          mTarget.begin_array(context);
+        }
+        else {
+          skipValue();
+        }
+        ++mDepth;
+      }
+      
+      void do_end_array(const context_type& context) override {
+        --mDepth;
+        if (forwarding()){
+          mTarget.end_array(context);
+        }
+        mNameMatches = false;
+      }
+      
+      void do_name(const Char* p, size_t length, const context_type& context) override {
+        if (forwarding()){
+          mTarget.name(p, length, context);
+        }
+        else if (mDepth == mMatched && mMatched <= mPath.names().size()){
+          const std::string& expected = mPath.names()[mMatched - 1];
+          mNameMatches = expected.size() == length && expected.compare(0, length, p, length) == 0;
+        }
+      }
+      
+      void do_null_value(const context_type& context) override {
+        if (forwarding()){
+          mTarget.value(jsoncons::null_type(), context);
+        }
+        else {
+          skipValue();
+        }
+      }
+      
+      void do_string_value(const Char* p, size_t length, const context_type& context) override {
+        if (forwarding()){
+          mTarget.value(p, length, context);
+        }
+        else {
+          skipValue();
+        }
+      }
+      
+      void do_double_value(double value, const context_type& context) override {
+        if (forwarding()){
+          mTarget.value(value, context);
+        }
+        else {
+          skipValue();
+        }
+      }
+      
+      void do_longlong_value(long long value, const context_type& context) override {
+        if (forwarding()){
+          mTarget.value(value, context);
+        }
+        else {
+          skipValue();
+        }
+      }
+      
+      void do_ulonglong_value(unsigned long long value, const context_type& context) override {
+        if (forwarding()){
+          mTarget.value(value, context);
+        }
+        else {
+          skipValue();
+        }
+      }
+      
+      void do_bool_value(bool value, const context_type& context) override {
+        if (forwarding()){
+          mTarget.value(value, context);
+        }
+        else {
+          skipValue();
+        }
+      }
+      
+      const subtree& mPath;
+      jsoncons::basic_json_input_handler<Char>& mTarget;
+      std::size_t mDepth;
+      std::size_t mMatched;
+      bool mNameMatches;
+      std::size_t mTargetDepth;
+      bool mFound;
+    };
+    
+  }
+
+  namespace internal{
+  
+    /*
+      Finds where the settings named by error paths lie, reading the
+      document again once a load has failed : each path gets the line and
+      column of its deepest member found in the document. The paths are
+      merged into a tree, each member name being looked up among the
+      children of its parent's node only
+    */
+    template <typename Char>
+    class PathLocator : public jsoncons::basic_json_input_handler<Char>{
+    
+    public:
+      //thrown once every path is found, to stop reading the rest of the document
+      struct complete{};
+      
+      struct Target{
+        explicit Target(const std::vector<std::string>& pNames)
+        : names(pNames)
+        , found(0)
+        , line(0)
+        , column(0){}
+        
+        std::vector<std::string> names;
+        //names found, plus one once the root is ; set by resolve()
+        std::size_t found;
+        unsigned long line;
+        unsigned long column;
+      };
+      
+      explicit PathLocator(std::vector<Target>& targets)
+      : mTargets(targets)
+      , mNodes(1)
+      , mEnds(targets.size())
+      , mParents()
+      , mCurrent(none)
+      , mLeft(0)
+      , mName(){
+        for (std::size_t t = 0; t < targets.size(); ++t){
+          std::size_t node = 0;
+          for (const auto& name : targets[t].names){
+            auto child = mNodes[node].children.insert(std::make_pair(name, mNodes.size()));
+            if (child.second){
+              mNodes.push_back(Node(node));
+            }
+            node = child.first->second;
+          }
+          if (!mNodes[node].end){
+            mNodes[node].end = true;
+            ++mLeft;
+          }
+          mEnds[t] = node;
+        }
+      }
+      
+      //gives each target the location of the deepest node of its path found while reading
+      void resolve(){
+        for (std::size_t t = 0; t < mTargets.size(); ++t){
+          std::size_t node = mEnds[t];
+          std::size_t found = mTargets[t].names.size() + 1;
+          while (!mNodes[node].seen && node != 0){
+            node = mNodes[node].parent;
+            --found;
+          }
+          if (mNodes[node].seen){
+            mTargets[t].found = found;
+            mTargets[t].line = mNodes[node].line;
+            mTargets[t].column = mNodes[node].column;
+          }
+        }
+      }
+      
+    private:
+      typedef jsoncons::basic_parsing_context<Char> context_type;
+      
+      static const std::size_t none = static_cast<std::size_t>(-1);
+      
+      struct Node{
+        explicit Node(std::size_t pParent = none)
+        : children()
+        , parent(pParent)
+        , end(false)
+        , seen(false)
+        , line(0)
+        , column(0){}
+        
+        std::unordered_map<std::string, std::size_t> children;
+        std::size_t parent;
+        //the last name of a target's path
+        bool end;
+        //the first occurence is the one located
+        bool seen;
+        unsigned long line;
+        unsigned long column;
+      };
+      
+      void record(std::size_t node, const context_type& context){
+        if (!mNodes[node].seen){
+          mNodes[node].seen = true;
+          mNodes[node].line = context.line_number();
+          mNodes[node].column = context.column_number();
+          if (mNodes[node].end && --mLeft == 0){
+            throw complete();
+          }
+        }
+      }
+      
+      //the members of a container are looked up below the node of the member it is the value of
+      void beginContainer(const context_type& context, bool isObject){
+        if (mParents.empty()){
+          mParents.push_back(isObject ? 0 : none);
+          record(0, context);
+        }
+        else {
+          mParents.push_back(isObject ? mCurrent : none);
+        }
+        mCurrent = none;
+      }
+      
+      void endContainer(){
+        mParents.pop_back();
+        mCurrent = none;
+      }
+      
+      void do_begin_json() override {}
+      
+      void do_end_json() override {}
+      
+      void do_begin_object(const context_type& context) override {
+        beginContainer(context, true);
+      }
+      
+      void do_end_object(const context_type&) override {
+        endContainer();
+      }
+      
+      //members inside arrays are never matched : their parent's name is missing from the path
+      void do_begin_array(const context_type& context) override {
+        beginContainer(context, false);
+      }
+      
+      void do_end_array(const context_type&) override {
+        endContainer();
+      }
+      
+      void do_name(const Char* p, size_t length, const context_type& context) override {
+        mCurrent = none;
+        const std::size_t parent = mParents.back();
+        if (parent == none || mNodes[parent].children.empty()){
+          return;
+        }
+        mName.assign(p, length);
+        auto child = mNodes[parent].children.find(mName);
+        if (child != mNodes[parent].children.end()){
+          mCurrent = child->second;
+          record(mCurrent, context);
+        }
+      }
+      
+      void do_null_value(const context_type&) override {}
+      
+      void do_string_value(const Char*, size_t, const context_type&) override {}
+      
+      void do_double_value(double, const context_type&) override {}
+      
+      void do_longlong_value(long long, const context_type&) override {}
+      
+      void do_ulonglong_value(unsigned long long, const context_type&) override {}
+      
+      void do_bool_value(bool, const context_type&) override {}
+      
+      std::vector<Target>& mTargets;
+      std::vector<Node> mNodes;
+      //node of the last name of each target
+      std::vector<std::size_t> mEnds;
+      //for each open container, the node its members are looked up below, none when they can't match
+      std::vector<std::size_t> mParents;
+      //node of the member whose value is being read, none when it matches no path
+      std::size_t mCurrent;
+      //ends of paths not found yet
+      std::size_t mLeft;
+      //member name being looked up, kept to reuse its storage
+      std::string mName;
+    };
+    
+    template <typename Char>
+    const std::size_t PathLocator<Char>::none;
+    
+    //gives the errors the line and column of their setting in the file, the root of the
+    //configuration lying at rootNames ; nothing is located when there is no file
+    inline void LocateInFile(const std::string& fileName, const std::vector<std::string>& rootNames, std::vector<ConfigError>& errors){
+      if (fileName.empty()){
+        return;
+      }
+      
+      std::vector<PathLocator<char>::Target> targets;
+      targets.reserve(errors.size());
+      for (const auto& error : errors){
+        std::vector<std::string> names(rootNames);
+        std::vector<std::string> path = error.getPathNames();
+        names.insert(names.end(), path.begin(), path.end());
+        targets.push_back(PathLocator<char>::Target(names));
+      }
+      
+      PathLocator<char> locator(targets);
+      try{
+        MappedFile file(fileName);
+        jsoncons::basic_json_reader<char> reader(file.data(), file.size(), locator);
+        reader.read();
+      }
+      catch (const PathLocator<char>::complete&){
+        //the rest of the document is not read
+      }
+      catch (...){
+        //the file changed since it was loaded : what was found so far is kept
+      }
+      locator.resolve();
+      
+      const std::shared_ptr<const std::string> sharedFileName = std::make_shared<const std::string>(fileName);
+      for (std::size_t i = 0; i < errors.size(); ++i){
+        if (targets[i].found > 0){
+          errors[i].setLocation(sharedFileName, targets[i].line, targets[i].column);
+        }
+      }
+    }
+    
+  }
+
+  namespace internal{
+  
+    //conversion of jsoncons values to setting types, shared by the jsoncons based loaders
+    template <typename JsonT>
+    class JsonconsExtractor{
+    
+    public:
+      typedef JsonT ValueType;
+      
+      void extract(const ValueType& from, const ValuePath& path, std::string& dest) const {
+
+        if (!from.is_string()){
+          throw std::string("value " + path.str() + " is expected to be a string");
+        }
+      
+        dest = from.as_string();
+      }
+    
+      void extract(const ValueType& from, const ValuePath& path, int8_t& dest) const {
+
+        if (!from.template is<short>() || from.template as<short>() < std::numeric_limits<int8_t>::min() || from.template as<short>() > std::numeric_limits<int8_t>::max()){
+          throw std::string("value " + path.str() + " is expected to be a int8_t");
+        }
+      
+        dest = static_cast<int8_t>(from.template as<short>());
+      }
+    
+      void extract(const ValueType& from, const ValuePath& path, uint8_t& dest) const {
+
+        if (!from.template is<unsigned short>() || from.template as<unsigned short>() > std::numeric_limits<uint8_t>::max()){
+          throw std::string("value " + path.str() + " is expected to be a uint8_t");
+        }
+      
+        dest = static_cast<uint8_t>(from.template as<unsigned short>());
+      }
+    
+      void extract(const ValueType& from, const ValuePath& path, float& dest) const {
+
+        if (!from.template is<double>()){
+          throw std::string("value " + path.str() + " is expected to be a float");
+        }
+      
+        dest = static_cast<float>(from.template as<double>());
+      }
+    
+      template <typename SettingType>
+      void extract(const ValueType& from, const ValuePath& path, SettingType& dest) const {
+      
+        if (!from.template is<SettingType>()) {
+          throw std::string("value " + path.str() + " is expected to be a "+internal::jsonconsTypeName<SettingType>());
+        }
+
+        dest = static_cast<SettingType>(from.template as<SettingType>());
+      }
+    
+      template <typename ValueT>
+      void extract(const ValueType& from, const ValuePath& path, std::vector<ValueT>& dest) const {
+      
+        if (!from.is_array()) {
+          throw std::string("value " + path.str() + " is expected to be an array");
+        }
+      
+        extractElements(from, path, dest, typename internal::ElementsKind<ValueT>::type());
+      }
+    
+    private:
+      template <typename ValueT>
+      void extractElements(const ValueType& from, const ValuePath& path, std::vector<ValueT>& dest, internal::genericElementsTag) const {
+      
+        dest.reserve(dest.size() + from.size());
+        for (std::size_t i = 0; i < from.size(); ++i){
+          ValueT outputValue;
+          extract(from[i], ValuePath(path, i), outputValue);
+          dest.push_back(outputValue);
+        }
+      }
+    
+      //integers are narrowed straight into the list, their range being checked once for the whole list
+      template <typename ValueT>
+      void extractElements(const ValueType& from, const ValuePath& path, std::vector<ValueT>& dest, internal::integerElementsTag) const {
+      
+        const std::size_t first = dest.size();
+        dest.resize(first + from.size());
+      
+        internal::IntegerBounds<ValueT> bounds;
+        bool allIntegers = true;
+        for (std::size_t i = 0; i < from.size(); ++i){
+          const ValueType& element = from[i];
+          if (element.is_ulonglong()){
+            bounds.add(element.as_ulonglong());
+            dest[first + i] = static_cast<ValueT>(element.as_ulonglong());
+          }
+          else if (element.is_longlong()){
+            bounds.add(element.as_longlong());
+            dest[first + i] = static_cast<ValueT>(element.as_longlong());
+          }
+          else {
+            allIntegers = false;
+          }
+        }
+      
+        if (!allIntegers || !bounds.fits()){
+          dest.resize(first);
+          //the element by element path reports the faulty element
+          extractElements(from, path, dest, internal::genericElementsTag());
+        }
+      }
+    
+      template <typename ValueT>
+      void extractElements(const ValueType& from, const ValuePath& path, std::vector<ValueT>& dest, internal::floatingElementsTag) const {
+      
+        const std::size_t first = dest.size();
+        dest.resize(first + from.size());
+      
+        bool allFloating = true;
+        for (std::size_t i = 0; i < from.size(); ++i){
+          const ValueType& element = from[i];
+          if (element.is_double()){
+            dest[first + i] = static_cast<ValueT>(element.as_double());
+          }
+          else {
+            allFloating = false;
+          }
+        }
+      
+        if (!allFloating){
+          dest.resize(first);
+          extractElements(from, path, dest, internal::genericElementsTag());
+        }
+      }
+    };
+    
+  }
+  
+  /*
+    Alloc is the allocator of the DOM the file is parsed into : 
+    std::allocator<void> for the heap, arena_allocator<void> for an arena
+    released in one go with the loader
+  */
+  template <typename Alloc = std::allocator<void> >
+  class basic_jsoncons_loader : public internal::JsonconsExtractor<jsoncons::basic_json<char, Alloc> >{
+
+  public:
+    typedef jsoncons::basic_json<char, Alloc> ValueType;
+
+  public:
+    //the file is parsed in place, memory mapped where the platform allows it
+    //throws jsoncons::json_parse_exception on error
+    basic_jsoncons_loader(const std::string& fileName)
+    : mFileName(fileName){
+    
+      internal::MappedFile file(fileName);
+      parse(file.data(), file.size());
+    }
+    
+    //the buffer is parsed where it lies, without being copied
+    //throws jsoncons::json_parse_exception on error
+    explicit basic_jsoncons_loader(const buffer_view& buffer){
+    
+      parse(buffer.data(), buffer.size());
+    }
+    
+#ifdef ICFG_JSONCONS_MMAP
+    //throws jsoncons::json_parse_exception on error
+    explicit basic_jsoncons_loader(const file_descriptor& descriptor){
+    
+      internal::MappedFile file(descriptor);
+      parse(file.data(), file.size());
+    }
+#endif
+    
+    //only the object at the given path is parsed into the DOM, and serves as the root of the configuration
+    //throws jsoncons::json_parse_exception on error
+    basic_jsoncons_loader(const std::string& fileName, const subtree& path)
+    : mFileName(fileName)
+    , mRootNames(path.names()){
+    
+      internal::MappedFile file(fileName);
+      typename internal::JsonconsDomMemory<Alloc>::scope domScope(mMemory);
+      jsoncons::basic_json_deserializer<char, Alloc> deserializer;
+      internal::SubtreeFilter<char> filter(path, deserializer);
+      jsoncons::basic_json_reader<char> reader(file.data(), file.size(), filter);
+      try{
+        reader.read();
+      }
+      catch (const typename internal::SubtreeFilter<char>::complete&){
+        //the rest of the document is not read
+      }
+      
+      if (!filter.found()){
+        throw std::string("subtree " + path.str() + " wasn't found in " + fileName);
+      }
+      deserializer.root().swap(mRoot);
+    }
+    
+    basic_jsoncons_loader(basic_jsoncons_loader&& other)
+    : mFileName(std::move(other.mFileName))
+    , mRootNames(std::move(other.mRootNames))
+    , mMemory(std::move(other.mMemory))
+    , mRoot(std::move(other.mRoot)){
+    
+    }
+    
+    //declaring the move constructor and destructor would delete the copies otherwise ;
+    //an arena loader stays move-only, as its arena can't be shared
+    basic_jsoncons_loader(const basic_jsoncons_loader&) = default;
+    basic_jsoncons_loader& operator=(const basic_jsoncons_loader&) = default;
+    basic_jsoncons_loader& operator=(basic_jsoncons_loader&&) = default;
+    
+    ~basic_jsoncons_loader(){
+      typename internal::JsonconsDomMemory<Alloc>::scope domScope(mMemory);
+      ValueType().swap(mRoot);
+    }
+    
+    const ValueType& getRoot() const {
+      return mRoot;
+    }
+    
+    bool hasValue(const ValueType& from, const std::string& settingName) const {
+      return from.has_member(settingName);
+    }
+    
+    template <typename Callback>
+    void forEachChild(const ValueType& from, Callback&& callback) const{
+      
+      if (from.template is<typename ValueType::object>()){
+        for (auto it = from.begin_members(); it != from.end_members(); ++it){
+          callback(it->name(), it->value());
+        }
+      }
+    }
+    
+    const ValueType& getContainedValue(const ValueType& from, const std::string& name) const{
+      return from[name];
+    }
+
+    template <typename SettingType>
+    void getValue(const ValueType& parent, const std::string& name, SettingType& dest) const {
+      const ValueType& from = parent[name];
+      
+      if (from.is_null()) {
+        throw std::string("missing value : " + name);
+      }
+
+      this->extract(from, ValuePath(name), dest);
+    }
+    
+    //gives the errors of a load the line and column of their setting, reading the file again :
+    //nothing is recorded while loading. Documents not read from a file are not located
+    void locate(std::vector<ConfigError>& errors) const {
+      internal::LocateInFile(mFileName, mRootNames, errors);
+    }
+    
+    //locates the errors found once the loader is gone, e.g. by a background validation
+    internal::ErrorLocator locator() const {
+      if (mFileName.empty()){
+        return internal::ErrorLocator();
+      }
+      const std::string fileName = mFileName;
+      const std::vector<std::string> rootNames = mRootNames;
+      return [fileName, rootNames](std::vector<ConfigError>& errors){
+        internal::LocateInFile(fileName, rootNames, errors);
+      };
+    }
+    
+  private:
+    void parse(const char* data, std::size_t length){
+      typename internal::JsonconsDomMemory<Alloc>::scope domScope(mMemory);
+      jsoncons::basic_json_deserializer<char, Alloc> deserializer;
+      jsoncons::basic_json_reader<char> reader(data, length, deserializer);
+      reader.read();
+      deserializer.root().swap(mRoot);
+    }
+    
+    //source and root of the document, to locate errors ; empty when not read from a file
+    std::string mFileName;
+    std::vector<std::string> mRootNames;
+    
+    //declared before the root so that the DOM is destroyed before its memory
+    internal::JsonconsDomMemory<Alloc> mMemory;
+    ValueType mRoot;
+
+  };
+  
+  typedef basic_jsoncons_loader<> jsoncons_loader;
+  typedef basic_jsoncons_loader<arena_allocator<void> > arena_jsoncons_loader;
+  
 }
 
-#endif //INSTANTCFG_JSONCONS_LOADER
\ No newline at end of file
+#endif //INSTANTCFG_JSONCONS_LOADER
@@ -0,0 +1,491 @@
+#ifndef INSTANTCFG_JSONCONS_PIPELINED_LOADER
+#define INSTANTCFG_JSONCONS_PIPELINED_LOADER
+
+#include "jsoncons_icfg_loader.h"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace icfg{
+
+  namespace internal{
+
+    /*
+      State shared by the stages of a pipelined load : blocks read ahead
+      from the file, and the top-level members parsed so far
+    */
+    struct PipelineState{
+      PipelineState()
+      : file()
+      , blocks()
+      , readDone(false)
+      , root()
+      , members()
+      , parseDone(false)
+      , error()
+      , stopping(false){}
+
+      std::mutex mutex;
+      std::condition_variable changed;
+
+      //source of the pipelined loader's I/O stage
+      std::ifstream file;
+      std::deque<std::string> blocks;
+      bool readDone;
+
+      //stands for the root object, whose members live in the members map
+      jsoncons::json root;
+      std::map<std::string, jsoncons::json> members;
+      bool parseDone;
+      std::string error;
+
+      //set when the loader is destroyed before the end of the file
+      bool stopping;
+    };
+
+    //input of the parse stage : each block read ahead by the I/O stage, in turn
+    class PipelineBuffer : public std::streambuf{
+
+    public:
+      explicit PipelineBuffer(PipelineState& state)
+      : mState(state)
+      , mBlock(){}
+
+    private:
+      int_type underflow() override {
+        {
+          std::unique_lock<std::mutex> lock(mState.mutex);
+          mState.changed.wait(lock, [this]{ return !mState.blocks.empty() || mState.readDone || mState.stopping; });
+          if (mState.blocks.empty() || mState.stopping){
+            return traits_type::eof();
+          }
+          mBlock.swap(mState.blocks.front());
+          mState.blocks.pop_front();
+        }
+        mState.changed.notify_all();
+
+        setg(&mBlock[0], &mBlock[0], &mBlock[0] + mBlock.size());
+        return traits_type::to_int_type(mBlock[0]);
+      }
+
+      PipelineState& mState;
+      std::string mBlock;
+    };
+
+    /*
+      Builds each top-level member of the document separately, and publishes
+      it as soon as it is complete
+    */
+    class MemberSplitter : public jsoncons::json_input_handler{
+
+    public:
+      explicit MemberSplitter(PipelineState& state)
+      : mState(state)
+      , mDepth(0)
+      , mName()
+      , mMember(){}
+
+    private:
+      typedef jsoncons::parsing_context context_type;
+
+      void publish(jsoncons::json&& value){
+        {
+          std::lock_guard<std::mutex> lock(mState.mutex);
+          //duplicated key : the first occurence is kept
+          mState.members.insert(std::make_pair(mName, std::move(value)));
+        }
+        mState.changed.notify_all();
+      }
+
+      //a container member starts : its events go to a deserializer of its own
+      void beginContainer(){
+        if (mDepth == 0){
+          throw std::string("the root of the document is expected to be an object");
+        }
+        if (mDepth == 1){
+          mMember.reset(new jsoncons::json_deserializer());
+        }
+        ++mDepth;
+      }
+
+      void endContainer(){
+        if (--mDepth == 1){
+          publish(std::move(mMember->root()));
+          mMember.reset();
+        }
+      }
+
+      template <typename T>
+      void scalar(const T& value, const context_type& context){
+        if (mDepth == 0){
+          throw std::string("the root of the document is expected to be an object");
+        }
+        if (mDepth == 1){
+          publish(jsoncons::json(value));
+        }
+        else {
+          mMember->value(value, context);
+        }
+      }
+
+      void do_begin_json() override {}
+
+      void do_end_json() override {}
+
+      void do_begin_object(const context_type& context) override {
+        if (mDepth == 0){
+          mDepth = 1;
+          return;
+        }
+        beginContainer();
+        mMember->begin_object(context);
+      }
+
+      void do_end_object(const context_type& context) override {
+        if (mDepth == 1){
+          mDepth = 0;
+          return;
+        }
+        mMember->end_object(context);
+        endContainer();
+      }
+
+      void do_begin_array(const context_type& context) override {
+        beginContainer();
+        mMember->begin_array(context);
+      }
+
+      void do_end_array(const context_type& context) override {
+        mMember->end_array(context);
+        endContainer();
+      }
+
+      void do_name(const char* p, size_t length, const context_type& context) override {
+        if (mDepth == 1){
+          mName.assign(p, length);
+        }
+        else {
+          mMember->name(p, length, context);
+        }
+      }
+
+      void do_null_value(const context_type& context) override {
+        scalar(jsoncons::null_type(), context);
+      }
+
+      void do_string_value(const char* p, size_t length, const context_type& context) override {
+        if (mDepth == 1){
+          publish(jsoncons::json(p, length));
+        }
+        else if (mDepth == 0){
+          throw std::string("the root of the document is expected to be an object");
+        }
+        else {
+          mMember->value(p, length, context);
+        }
+      }
+
+      void do_double_value(double value, const context_type& context) override {
+        scalar(value, context);
+      }
+
+      void do_longlong_value(long long value, const context_type& context) override {
+        scalar(value, context);
+      }
+
+      void do_ulonglong_value(unsigned long long value, const context_type& context) override {
+        scalar(value, context);
+      }
+
+      void do_bool_value(bool value, const context_type& context) override {
+        scalar(value, context);
+      }
+
+      PipelineState& mState;
+      std::size_t mDepth;
+      std::string mName;
+      std::unique_ptr<jsoncons::json_deserializer> mMember;
+    };
+
+    /*
+      Loader over the members published by a parse stage running on its own
+      thread, whatever feeds it : a root member lookup waits until that
+      member is parsed
+    */
+    class PublishedMembersLoader : public JsonconsExtractor<jsoncons::json>{
+
+    public:
+      typedef jsoncons::json ValueType;
+
+    public:
+      PublishedMembersLoader(PublishedMembersLoader&& other)
+      : mState(std::move(other.mState))
+      , mSource(std::move(other.mSource))
+      , mParser(std::move(other.mParser)){
+
+      }
+
+      ~PublishedMembersLoader(){
+        stop();
+      }
+
+      //waits for the end of the parse : a syntax error past the last bound member is only reported here
+      void wait() const {
+        std::unique_lock<std::mutex> lock(mState->mutex);
+        mState->changed.wait(lock, [this]{ return mState->parseDone; });
+        throwOnError();
+      }
+      
+      //called once the settings are bound : the rest of the document must be valid too
+      void finishBinding() const {
+        wait();
+      }
+
+      const ValueType& getRoot() const {
+        return mState->root;
+      }
+
+      bool hasValue(const ValueType& from, const std::string& settingName) const {
+        if (&from == &mState->root){
+          return member(settingName) != nullptr;
+        }
+        return from.has_member(settingName);
+      }
+
+      template <typename Callback>
+      void forEachChild(const ValueType& from, Callback&& callback) const{
+
+        if (from.is<ValueType::object>()){
+          for (auto it = from.begin_members(); it != from.end_members(); ++it){
+            callback(it->name(), it->value());
+          }
+        }
+      }
+
+      const ValueType& getContainedValue(const ValueType& from, const std::string& name) const{
+        if (&from == &mState->root){
+          const ValueType* value = member(name);
+          return value != nullptr ? *value : from[name];
+        }
+        return from[name];
+      }
+
+      template <typename SettingType>
+      void getValue(const ValueType& parent, const std::string& name, SettingType& dest) const {
+        const ValueType& from = getContainedValue(parent, name);
+
+        if (from.is_null()) {
+          throw std::string("missing value : " + name);
+        }
+
+        this->extract(from, ValuePath(name), dest);
+      }
+
+    protected:
+      static const std::size_t sReadAhead = 16;
+
+      explicit PublishedMembersLoader(const std::string& source)
+      : mState(new PipelineState())
+      , mSource(source)
+      , mParser(){
+
+      }
+
+      void startParser(){
+        PipelineState* state = mState.get();
+        mParser = std::thread([state]{ parse(*state); });
+      }
+
+      //ends the parse early when the loader goes away before the end of the input
+      void stop(){
+        if (mState && mParser.joinable()){
+          {
+            std::lock_guard<std::mutex> lock(mState->mutex);
+            mState->stopping = true;
+          }
+          mState->changed.notify_all();
+          mParser.join();
+        }
+      }
+
+      //to be called with the state locked
+      void throwOnError() const {
+        if (!mState->error.empty()){
+          throw std::string("parse error in " + mSource + " : " + mState->error);
+        }
+      }
+
+      std::unique_ptr<PipelineState> mState;
+
+    private:
+      static void parse(PipelineState& state){
+        std::string error;
+        try{
+          PipelineBuffer buffer(state);
+          std::istream input(&buffer);
+          MemberSplitter splitter(state);
+          jsoncons::json_reader reader(input, splitter);
+          reader.read();
+          //the input is read to its end, where anything but whitespace after the document is an error
+          reader.check_done();
+        }
+        catch (const std::exception& e){
+          error = e.what();
+        }
+        catch (const std::string& e){
+          error = e;
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(state.mutex);
+          state.parseDone = true;
+          state.error = error;
+        }
+        state.changed.notify_all();
+      }
+
+      //waits until the top-level member is parsed, or the whole document is without it
+      const ValueType* member(const std::string& name) const {
+        std::unique_lock<std::mutex> lock(mState->mutex);
+        std::map<std::string, ValueType>::const_iterator found;
+        mState->changed.wait(lock, [&]{
+          found = mState->members.find(name);
+          return found != mState->members.end() || mState->parseDone;
+        });
+        if (found != mState->members.end()){
+          return &found->second;
+        }
+        throwOnError();
+        return nullptr;
+      }
+
+      std::string mSource;
+      std::thread mParser;
+    };
+
+  }
+
+  /*
+    Pipelined jsoncons loader : a thread reads the file ahead in blocks,
+    a second one parses them and publishes every top-level member once
+    complete, and the settings are bound on the calling thread as soon as
+    the member they belong to is available. Loading a large multi-section
+    file then takes about the time of its slowest stage.
+  */
+  class jsoncons_pipelined_loader : public internal::PublishedMembersLoader{
+
+  public:
+    jsoncons_pipelined_loader(const std::string& fileName)
+    : internal::PublishedMembersLoader(fileName)
+    , mReader(){
+
+      mState->file.open(fileName.c_str(), std::ios::in | std::ios::binary);
+      if (!mState->file.is_open()){
+        throw std::string("couldn't open config file " + fileName);
+      }
+
+      internal::PipelineState* state = mState.get();
+      mReader = std::thread([state]{ read(*state); });
+      startParser();
+    }
+
+    jsoncons_pipelined_loader(jsoncons_pipelined_loader&& other)
+    : internal::PublishedMembersLoader(std::move(other))
+    , mReader(std::move(other.mReader)){
+
+    }
+
+    ~jsoncons_pipelined_loader(){
+      stop();
+      if (mReader.joinable()){
+        mReader.join();
+      }
+    }
+
+  private:
+    static const std::size_t sBlockSize = 1024 * 1024;
+
+    //I/O stage
+    static void read(internal::PipelineState& state){
+      for (;;){
+        std::string block(sBlockSize, '\0');
+        state.file.read(&block[0], block.size());
+        block.resize(static_cast<std::size_t>(state.file.gcount()));
+
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.changed.wait(lock, [&state]{ return state.blocks.size() < sReadAhead || state.parseDone || state.stopping; });
+        if (block.empty() || state.parseDone || state.stopping){
+          state.readDone = true;
+          lock.unlock();
+          state.changed.notify_all();
+          return;
+        }
+        state.blocks.push_back(std::move(block));
+        lock.unlock();
+        state.changed.notify_all();
+      }
+    }
+
+    std::thread mReader;
+  };
+
+  /*
+    Push jsoncons loader : the document is fed in chunks of any size as they
+    arrive, from a socket or a pipe, and parsed as it comes on a thread of
+    its own ; only the chunks not parsed yet are held, never the whole text.
+    Once finish() returns, the loader binds like any other.
+  */
+  class jsoncons_push_loader : public internal::PublishedMembersLoader{
+
+  public:
+    //the source only names the document in error messages
+    explicit jsoncons_push_loader(const std::string& source = "pushed document")
+    : internal::PublishedMembersLoader(source){
+
+      startParser();
+    }
+
+    jsoncons_push_loader(jsoncons_push_loader&& other)
+    : internal::PublishedMembersLoader(std::move(other)){
+
+    }
+
+    //waits while the parse is sReadAhead chunks behind
+    //throws as soon as the document fed so far is known to be invalid, including when something follows its end
+    void feed(const char* data, std::size_t length){
+      std::unique_lock<std::mutex> lock(mState->mutex);
+      if (mState->readDone){
+        throw std::string("cannot feed a document after finish()");
+      }
+      mState->changed.wait(lock, [this]{ return mState->blocks.size() < sReadAhead || mState->parseDone; });
+      throwOnError();
+      if (length == 0){
+        return;
+      }
+      mState->blocks.push_back(std::string(data, length));
+      lock.unlock();
+      mState->changed.notify_all();
+    }
+
+    void feed(const std::string& chunk){
+      feed(chunk.data(), chunk.size());
+    }
+
+    //marks the end of the document, and waits for the end of its parse
+    void finish(){
+      {
+        std::lock_guard<std::mutex> lock(mState->mutex);
+        mState->readDone = true;
+      }
+      mState->changed.notify_all();
+      wait();
+    }
+  };
+
+}
+
+#endif //INSTANTCFG_JSONCONS_PIPELINED_LOADER
@@ -0,0 +1,588 @@
+#ifndef INSTANTCFG_JSONCONS_TAPE_LOADER
+#define INSTANTCFG_JSONCONS_TAPE_LOADER
+
+#include "jsoncons_icfg_loader.h"
+
+#include <memory>
+#include <cstring>
+#include <thread>
+
+namespace icfg{
+
+  namespace internal{
+
+    /*
+      One value of the document, as recorded by the structural scan :
+      containers know where their content ends on the tape, strings and
+      scalars are only located in the input, not decoded
+    */
+    struct TapeEntry{
+      enum Kind{
+        objectEntry,
+        arrayEntry,
+        keyEntry,
+        stringEntry,
+        scalarEntry
+      };
+
+      Kind kind;
+      //strings and keys holding escape sequences
+      bool escaped;
+      //offset of the first character, after the quote for strings and keys
+      std::size_t begin;
+      //offset past the last character, the closing quote for strings and keys
+      std::size_t end;
+      //index of the entry following this value and everything it contains
+      std::size_t next;
+    };
+
+    /*
+      Positions of the structural characters of a document (brackets, 
+      separators, quotes, first character of scalars), found by several
+      threads each scanning one chunk of the input
+    */
+    class StructuralIndex{
+    
+    public:
+      StructuralIndex()
+      : mChunks()
+      , mChunk(0)
+      , mToken(0)
+      , mSize(0){}
+      
+      //false when the document holds comments or stray backslashes, left to the sequential scan
+      bool build(const char* data, std::size_t length, unsigned threads){
+      
+        std::vector<std::size_t> bounds = chunkBounds(data, length, threads);
+        const std::size_t chunkCount = bounds.size() - 1;
+        
+        //first pass : quotes and separators of each chunk. The parity of the quotes tells whether a chunk starts within a string,
+        //and their count bounds the positions the chunk holds
+        std::vector<ChunkCounts> counts(chunkCount);
+        runChunks(chunkCount, [&](std::size_t chunk){
+          counts[chunk] = countChunk(data, bounds[chunk], bounds[chunk + 1]);
+        });
+        
+        std::vector<char> startsInString(chunkCount, 0);
+        for (std::size_t chunk = 1; chunk < chunkCount; ++chunk){
+          startsInString[chunk] = startsInString[chunk - 1] != (counts[chunk - 1].quotes % 2 == 1);
+        }
+        
+        //second pass : structural positions of each chunk
+        mChunks.assign(chunkCount, std::vector<std::size_t>());
+        std::vector<char> sequentialOnly(chunkCount, 0);
+        runChunks(chunkCount, [&](std::size_t chunk){
+          //every scalar follows a separator : a chunk holds at most its quotes, its separators and as many scalars
+          mChunks[chunk].reserve(counts[chunk].quotes + 2 * counts[chunk].separators + 1);
+          sequentialOnly[chunk] = !indexChunk(data, bounds[chunk], bounds[chunk + 1], startsInString[chunk] != 0, mChunks[chunk]);
+        });
+        
+        mChunk = 0;
+        mToken = 0;
+        mSize = 0;
+        for (std::size_t chunk = 0; chunk < chunkCount; ++chunk){
+          mSize += mChunks[chunk].size();
+        }
+        return std::find(sequentialOnly.begin(), sequentialOnly.end(), 1) == sequentialOnly.end();
+      }
+      
+      //first structural position at or after the given one, the end of the document if none ; positions only move forward
+      std::size_t next(std::size_t position, std::size_t length){
+        while (mChunk < mChunks.size()){
+          const std::vector<std::size_t>& tokens = mChunks[mChunk];
+          while (mToken < tokens.size() && tokens[mToken] < position){
+            ++mToken;
+          }
+          if (mToken < tokens.size()){
+            return tokens[mToken];
+          }
+          ++mChunk;
+          mToken = 0;
+        }
+        return length;
+      }
+      
+      //number of structural positions found
+      std::size_t size() const {
+        return mSize;
+      }
+      
+    private:
+      struct ChunkCounts{
+        ChunkCounts()
+        : quotes(0)
+        , separators(0){}
+        
+        std::size_t quotes;
+        //brackets, colons and commas
+        std::size_t separators;
+      };
+      
+      //a chunk never starts right after a backslash, so that no escape sequence straddles two chunks
+      static std::vector<std::size_t> chunkBounds(const char* data, std::size_t length, unsigned threads){
+        std::vector<std::size_t> bounds(1, 0);
+        for (unsigned i = 1; i < threads; ++i){
+          std::size_t bound = std::max(bounds.back(), length / threads * i);
+          while (bound < length && bound > 0 && data[bound - 1] == '\\'){
+            ++bound;
+          }
+          bounds.push_back(bound);
+        }
+        bounds.push_back(length);
+        return bounds;
+      }
+      
+      //the threads already started are joined before an error is passed on, when a thread can't be started
+      template <typename Task>
+      static void runChunks(std::size_t chunkCount, Task task){
+        std::vector<std::thread> workers;
+        workers.reserve(chunkCount);
+        try{
+          for (std::size_t chunk = 1; chunk < chunkCount; ++chunk){
+            workers.push_back(std::thread(task, chunk));
+          }
+          task(0);
+        }
+        catch (...){
+          joinAll(workers);
+          throw;
+        }
+        joinAll(workers);
+      }
+      
+      static void joinAll(std::vector<std::thread>& workers){
+        for (std::size_t i = 0; i < workers.size(); ++i){
+          workers[i].join();
+        }
+      }
+      
+      static ChunkCounts countChunk(const char* data, std::size_t begin, std::size_t end){
+        ChunkCounts counts;
+        for (std::size_t i = begin; i < end; ++i){
+          switch (data[i]){
+          case '\\':
+            ++i;
+            break;
+          case '"':
+            ++counts.quotes;
+            break;
+          case '{': case '}': case '[': case ']': case ':': case ',':
+            ++counts.separators;
+            break;
+          }
+        }
+        return counts;
+      }
+      
+      //strchr finds the terminator too : a NUL is never a delimiter
+      static bool isDelimiter(char c){
+        return c != '\0' && std::strchr(" \t\r\n,:[]{}\"", c) != nullptr;
+      }
+      
+      static bool indexChunk(const char* data, std::size_t begin, std::size_t end, bool inString, std::vector<std::size_t>& tokens){
+        for (std::size_t i = begin; i < end; ++i){
+          const char c = data[i];
+          if (inString){
+            if (c == '\\'){
+              ++i;
+            }
+            else if (c == '"'){
+              tokens.push_back(i);
+              inString = false;
+            }
+            continue;
+          }
+          switch (c){
+          case ' ': case '\t': case '\r': case '\n':
+            break;
+          case '{': case '}': case '[': case ']': case ':': case ',':
+            tokens.push_back(i);
+            break;
+          case '"':
+            tokens.push_back(i);
+            inString = true;
+            break;
+          case '/': case '\\':
+            return false;
+          default:
+            if (i == 0 || isDelimiter(data[i - 1])){
+              tokens.push_back(i);
+            }
+          }
+        }
+        return true;
+      }
+      
+      std::vector<std::vector<std::size_t> > mChunks;
+      std::size_t mChunk;
+      std::size_t mToken;
+      std::size_t mSize;
+    };
+    
+    /*
+      Structural scan of a json document into a flat tape : brackets, member
+      names and value boundaries are checked, values themselves are decoded
+      on demand only
+    */
+    class TapeScanner{
+
+    public:
+      //with an index, the scan jumps from one structural position to the next instead of reading every character
+      TapeScanner(const char* data, std::size_t length, const std::string& source, std::vector<TapeEntry>& tape, StructuralIndex* index = nullptr)
+      : mData(data)
+      , mLength(length)
+      , mPos(0)
+      , mSource(source)
+      , mTape(tape)
+      , mIndex(index){}
+
+      void scan(){
+        std::vector<std::size_t> open;
+        bool expectValue = true;
+
+        while (expectValue || !open.empty()){
+          char c = current();
+          if (expectValue){
+            if (c == '{' || c == '['){
+              open.push_back(push(c == '{' ? TapeEntry::objectEntry : TapeEntry::arrayEntry, mPos, mPos, false));
+              ++mPos;
+              if (current() == (c == '{' ? '}' : ']')){
+                close(open);
+                expectValue = false;
+              }
+              else if (c == '{'){
+                scanKey();
+              }
+            }
+            else {
+              if (c == '"'){
+                scanString(TapeEntry::stringEntry);
+              }
+              else {
+                scanScalar();
+              }
+              expectValue = false;
+            }
+          }
+          else if (c == ','){
+            ++mPos;
+            if (mTape[open.back()].kind == TapeEntry::objectEntry){
+              scanKey();
+            }
+            expectValue = true;
+          }
+          else if (c == (mTape[open.back()].kind == TapeEntry::objectEntry ? '}' : ']')){
+            close(open);
+          }
+          else {
+            fail("expected ',' or the end of the enclosing value");
+          }
+        }
+
+        skipBlanks();
+        if (mPos != mLength){
+          fail("unexpected content after the end of the document");
+        }
+      }
+
+    private:
+      std::size_t push(TapeEntry::Kind kind, std::size_t begin, std::size_t end, bool escaped){
+        TapeEntry entry;
+        entry.kind = kind;
+        entry.escaped = escaped;
+        entry.begin = begin;
+        entry.end = end;
+        entry.next = mTape.size() + 1;
+        mTape.push_back(entry);
+        return mTape.size() - 1;
+      }
+
+      void close(std::vector<std::size_t>& open){
+        TapeEntry& container = mTape[open.back()];
+        open.pop_back();
+        ++mPos;
+        container.end = mPos;
+        container.next = mTape.size();
+      }
+
+      void scanKey(){
+        if (current() != '"'){
+          fail("expected a member name");
+        }
+        scanString(TapeEntry::keyEntry);
+        if (current() != ':'){
+          fail("expected ':' after a member name");
+        }
+        ++mPos;
+      }
+
+      void scanString(TapeEntry::Kind kind){
+        const std::size_t begin = mPos + 1;
+        if (mIndex != nullptr){
+          const std::size_t end = mIndex->next(begin, mLength);
+          if (end >= mLength){
+            fail("unterminated string");
+          }
+          push(kind, begin, end, std::memchr(mData + begin, '\\', end - begin) != nullptr);
+          mPos = end + 1;
+          return;
+        }
+        
+        bool escaped = false;
+        std::size_t i = begin;
+        while (i < mLength && mData[i] != '"'){
+          if (mData[i] == '\\'){
+            escaped = true;
+            ++i;
+          }
+          ++i;
+        }
+        if (i >= mLength){
+          fail("unterminated string");
+        }
+        push(kind, begin, i, escaped);
+        mPos = i + 1;
+      }
+
+      void scanScalar(){
+        const std::size_t begin = mPos;
+        if (mData[mPos] == '\0' || std::strchr("-0123456789tfn", mData[mPos]) == nullptr){
+          fail("expected a value");
+        }
+        while (mPos < mLength && (mData[mPos] == '\0' || std::strchr(" \t\r\n,:]}[{\"/", mData[mPos]) == nullptr)){
+          ++mPos;
+        }
+        push(TapeEntry::scalarEntry, begin, mPos, false);
+      }
+
+      //skips blanks and comments, and returns the character following them
+      char current(){
+        skipBlanks();
+        if (mPos >= mLength){
+          fail("unexpected end of file");
+        }
+        return mData[mPos];
+      }
+
+      void skipBlanks(){
+        if (mIndex != nullptr){
+          mPos = mIndex->next(mPos, mLength);
+          return;
+        }
+        while (mPos < mLength){
+          const char c = mData[mPos];
+          if (c == ' ' || c == '\t' || c == '\r' || c == '\n'){
+            ++mPos;
+          }
+          else if (c == '/' && mPos + 1 < mLength && mData[mPos + 1] == '/'){
+            while (mPos < mLength && mData[mPos] != '\n'){
+              ++mPos;
+            }
+          }
+          else if (c == '/' && mPos + 1 < mLength && mData[mPos + 1] == '*'){
+            mPos += 2;
+            while (mPos + 1 < mLength && !(mData[mPos] == '*' && mData[mPos + 1] == '/')){
+              ++mPos;
+            }
+            mPos += 2;
+          }
+          else {
+            return;
+          }
+        }
+      }
+
+      //the position is only turned into a line and a column when reporting an error
+      void fail(const std::string& message) const {
+        std::size_t line = 1;
+        std::size_t lineStart = 0;
+        for (std::size_t i = 0; i < mPos && i < mLength; ++i){
+          if (mData[i] == '\n'){
+            ++line;
+            lineStart = i + 1;
+          }
+        }
+        throw std::string("parse error in " + mSource + " at line " + std::to_string(line) + ", column " + std::to_string(mPos - lineStart + 1) + " : " + message);
+      }
+
+      const char* mData;
+      std::size_t mLength;
+      std::size_t mPos;
+      const std::string& mSource;
+      std::vector<TapeEntry>& mTape;
+      StructuralIndex* mIndex;
+    };
+
+  }
+
+  //number of threads the structural scan of a large document is split across
+  class parallel_scan{
+  
+  public:
+    explicit parallel_scan(unsigned threads = std::thread::hardware_concurrency())
+    : mThreads(threads == 0 ? 1 : threads){}
+    
+    unsigned threads() const {
+      return mThreads;
+    }
+    
+  private:
+    unsigned mThreads;
+  };
+  
+  /*
+    Lazy jsoncons loader : the file is only scanned for its structure when
+    loaded, each value being decoded by jsoncons when a setting binds it.
+    Parts of the document no setting refers to are never decoded.
+  */
+  class jsoncons_tape_loader : public internal::JsonconsExtractor<jsoncons::json>{
+
+  public:
+    typedef internal::TapeEntry ValueType;
+
+  public:
+    //throws std::string on error
+    jsoncons_tape_loader(const std::string& fileName)
+    : mFile(new internal::MappedFile(fileName))
+    , mTape(){
+
+      internal::TapeScanner(mFile->data(), mFile->size(), fileName, mTape).scan();
+      checkRoot(fileName);
+    }
+    
+    //the structure of the document is first indexed by several threads, each on a chunk of at least sMinimumChunkSize bytes
+    //documents holding comments are scanned sequentially
+    jsoncons_tape_loader(const std::string& fileName, const parallel_scan& mode)
+    : mFile(new internal::MappedFile(fileName))
+    , mTape(){
+    
+      const std::size_t threads = std::min<std::size_t>(mode.threads(), mFile->size() / sMinimumChunkSize);
+      internal::StructuralIndex index;
+      const bool indexed = threads > 1 && index.build(mFile->data(), mFile->size(), static_cast<unsigned>(threads));
+      //a value spans at least two structural positions : its start, and its end or the separator after it
+      if (indexed){
+        mTape.reserve(index.size() / 2 + 1);
+      }
+      internal::TapeScanner(mFile->data(), mFile->size(), fileName, mTape, indexed ? &index : nullptr).scan();
+      checkRoot(fileName);
+    }
+
+    const ValueType& getRoot() const {
+      return mTape.front();
+    }
+
+    bool hasValue(const ValueType& from, const std::string& settingName) const {
+      return findMember(from, settingName) != nullptr;
+    }
+
+    template <typename Callback>
+    void forEachChild(const ValueType& from, Callback&& callback) const{
+
+      if (from.kind == ValueType::objectEntry){
+        for (std::size_t key = indexOf(from) + 1; key < from.next; key = mTape[key + 1].next){
+          callback(decodeKey(mTape[key]), mTape[key + 1]);
+        }
+      }
+    }
+
+    const ValueType& getContainedValue(const ValueType& from, const std::string& name) const{
+      const ValueType* member = findMember(from, name);
+      if (member == nullptr){
+        throw std::string("missing value : " + name);
+      }
+      return *member;
+    }
+
+    template <typename SettingType>
+    void getValue(const ValueType& parent, const std::string& name, SettingType& dest) const {
+      const ValueType* member = findMember(parent, name);
+
+      jsoncons::json from;
+      if (member != nullptr){
+        decode(*member, name, from);
+      }
+      if (member == nullptr || from.is_null()) {
+        throw std::string("missing value : " + name);
+      }
+
+      extract(from, ValuePath(name), dest);
+    }
+
+  private:
+    static const std::size_t sMinimumChunkSize = 1024 * 1024;
+    
+    void checkRoot(const std::string& fileName) const {
+      if (mTape.front().kind != ValueType::objectEntry){
+        throw std::string("the root of " + fileName + " is expected to be an object");
+      }
+    }
+    
+    std::size_t indexOf(const ValueType& entry) const {
+      return static_cast<std::size_t>(&entry - &mTape.front());
+    }
+
+    const ValueType* findMember(const ValueType& from, const std::string& name) const {
+
+      if (from.kind != ValueType::objectEntry){
+        return nullptr;
+      }
+      for (std::size_t key = indexOf(from) + 1; key < from.next; key = mTape[key + 1].next){
+        const ValueType& entry = mTape[key];
+        const bool matches = entry.escaped
+                           ? decodeKey(entry) == name
+                           : entry.end - entry.begin == name.size() && name.compare(0, name.size(), mFile->data() + entry.begin, name.size()) == 0;
+        if (matches){
+          return &mTape[key + 1];
+        }
+      }
+      return nullptr;
+    }
+
+    std::string decodeKey(const ValueType& key) const {
+      if (!key.escaped){
+        return std::string(mFile->data() + key.begin, key.end - key.begin);
+      }
+      jsoncons::json decoded;
+      decode(key, "member name", decoded);
+      return decoded.as_string();
+    }
+
+    void decode(const ValueType& entry, const std::string& name, jsoncons::json& dest) const {
+
+      const char* data = mFile->data();
+      if ((entry.kind == ValueType::stringEntry || entry.kind == ValueType::keyEntry) && !entry.escaped){
+        jsoncons::json(data + entry.begin, entry.end - entry.begin).swap(dest);
+        return;
+      }
+
+      try{
+        jsoncons::json_deserializer deserializer;
+        if (entry.kind == ValueType::objectEntry || entry.kind == ValueType::arrayEntry){
+          jsoncons::json_reader reader(data + entry.begin, entry.end - entry.begin, deserializer);
+          reader.read();
+          deserializer.root().swap(dest);
+        }
+        else {
+          //jsoncons only reads arrays and objects at the top level
+          const std::size_t begin = entry.kind == ValueType::scalarEntry ? entry.begin : entry.begin - 1;
+          const std::size_t end = entry.kind == ValueType::scalarEntry ? entry.end : entry.end + 1;
+          std::string wrapped = "[" + std::string(data + begin, end - begin) + "]";
+          jsoncons::json_reader reader(wrapped.data(), wrapped.size(), deserializer);
+          reader.read();
+          deserializer.root()[0].swap(dest);
+        }
+      }
+      catch (const std::exception& error){
+        throw std::string("invalid value " + name + " : " + error.what());
+      }
+    }
+
+  private:
+    //the tape refers to the file content, kept mapped for the lifetime of the loader
+    std::unique_ptr<internal::MappedFile> mFile;
+    std::vector<ValueType> mTape;
+  };
+
+}
+
+#endif //INSTANTCFG_JSONCONS_TAPE_LOADER
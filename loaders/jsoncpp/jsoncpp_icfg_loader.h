@@ -4,8 +4,18 @@
 #include <json/reader.h>
 #include <json/value.h>
 
+#include "../../instantConfig.h"
+
 #include <iterator>
 #include <fstream>
+#include <limits>
+#include <algorithm>
+#include <cerrno>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define ICFG_JSONCPP_FILE_DESCRIPTOR
+#endif
 
 class jsoncppLoader{
 
@@ -14,7 +24,8 @@ public:
 
 public:
 
-  jsoncppLoader(const std::string& fileName){
+  jsoncppLoader(const std::string& fileName)
+  : mFileName(fileName){
   
     std::string fileContent;
     std::ifstream file(fileName.c_str());
@@ -25,14 +36,47 @@ public:
     file>>std::noskipws;
     
     std::copy(std::istream_iterator<char>(file), std::istream_iterator<char>(), std::back_inserter(fileContent));
-    Json::Reader reader;
-    bool success = reader.parse(fileContent, mRoot);
-    
-    if (!success){
-      throw std::string("parse error in file "+fileName + " : "+reader.getFormattedErrorMessages());
+    parse(fileContent.data(), fileContent.size(), "file " + fileName);
+  }
+  
+  //the buffer is parsed where it lies, without being copied
+  explicit jsoncppLoader(const icfg::buffer_view& buffer){
+    parse(buffer.data(), buffer.size(), "buffer");
+  }
+  
+#ifdef ICFG_JSONCPP_FILE_DESCRIPTOR
+  //the descriptor is read until its end, from its current offset
+  explicit jsoncppLoader(const icfg::file_descriptor& descriptor){
+  
+    std::string content;
+    char block[65536];
+    for (;;){
+      ssize_t count = ::read(descriptor.get(), block, sizeof(block));
+      if (count < 0 && errno == EINTR){
+        continue;
+      }
+      if (count < 0){
+        throw std::string("couldn't read config from " + descriptor.name());
+      }
+      if (count == 0){
+        break;
+      }
+      content.append(block, static_cast<std::size_t>(count));
     }
+    parse(content.data(), content.size(), descriptor.name());
+  }
+#endif
+  
+  jsoncppLoader(jsoncppLoader&& other)
+  : mFileName(std::move(other.mFileName)){
+    mRoot.swap(other.mRoot);
   }
   
+  //declaring the move constructor would delete the copies otherwise
+  jsoncppLoader(const jsoncppLoader&) = default;
+  jsoncppLoader& operator=(const jsoncppLoader&) = default;
+  jsoncppLoader& operator=(jsoncppLoader&&) = default;
+  
   const ValueType& getRoot() const {
     return mRoot;
   }
@@ -41,8 +85,14 @@ public:
     return from.isMember(settingName);
   }
   
-  std::vector<std::string> getContainedValues(const ValueType& from) const{
-    return from.getMemberNames();
+  template <typename Callback>
+  void forEachChild(const ValueType& from, Callback&& callback) const{
+    
+    if (from.isObject()){
+      for (ValueType::const_iterator it = from.begin(); it != from.end(); ++it){
+        callback(it.name(), *it);
+      }
+    }
   }
   
   const ValueType& getContainedValue(const ValueType& from, const std::string& name) const{
@@ -51,138 +101,275 @@ public:
 
   template <typename SettingType>
   void getValue(const ValueType& parent, const std::string& name, SettingType& dest) const {
-	  Json::Value from = parent[name];
+	  const Json::Value& from = parent[name];
 	  
 	  if (from.isNull()) {
 		  throw std::string("missing value : " + name);
 	  }
 
-	  extract(from, name, dest);
+	  extract(from, icfg::ValuePath(name), dest);
   }
   
-  void extract(const ValueType& from, const std::string& name, std::string& dest) const {
+  //gives the errors of a load the line and column of their setting, from the offsets jsoncpp keeps
+  //in its values : the file is only read again up to them. Documents not read from a file are not located
+  void locate(std::vector<icfg::ConfigError>& errors) const {
+    if (!mFileName.empty()){
+      locateIn(mFileName, mRoot, errors);
+    }
+  }
+  
+  //locates the errors found once the loader is gone, e.g. by a background validation :
+  //the document is then parsed again, for the offsets of its values
+  icfg::internal::ErrorLocator locator() const {
+    if (mFileName.empty()){
+      return icfg::internal::ErrorLocator();
+    }
+    const std::string fileName = mFileName;
+    return [fileName](std::vector<icfg::ConfigError>& errors){
+      std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+      const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+      ValueType root;
+      Json::Reader reader;
+      if (reader.parse(content.data(), content.data() + content.size(), root)){
+        locateIn(fileName, root, errors);
+      }
+    };
+  }
+  
+  void extract(const ValueType& from, const icfg::ValuePath& path, std::string& dest) const {
 
     if (!from.isString()){
-      throw std::string("value "+name+" is expected to be a string");
+      throw std::string("value " + path.str() + " is expected to be a string");
     }
     
     dest = from.asString();
   }
 
-  void extract(const ValueType& from, const std::string& name, bool& dest) const {
+  void extract(const ValueType& from, const icfg::ValuePath& path, bool& dest) const {
 	  
 	  if (!from.isBool()) {
-		  throw std::string("value " + name + " is expected to be a boolean");
+		  throw std::string("value " + path.str() + " is expected to be a boolean");
 	  }
 
 	  dest = static_cast<bool>(from.asBool());
   }
   
-  void extract(const ValueType& from, const std::string& name, int8_t& dest) const{
+  void extract(const ValueType& from, const icfg::ValuePath& path, int8_t& dest) const{
     
-    if (!from.isInt()){
-      throw std::string("value "+name+" is expected to be an integer");
+    if (!from.isInt() || from.asInt() < std::numeric_limits<int8_t>::min() || from.asInt() > std::numeric_limits<int8_t>::max()){
+      throw std::string("value " + path.str() + " is expected to be an integer");
     }
     
     dest = static_cast<int8_t>(from.asInt());
   }
   
-  void extract(const ValueType& from, const std::string& name, uint8_t& dest) const{
+  void extract(const ValueType& from, const icfg::ValuePath& path, uint8_t& dest) const{
     
-    if (!from.isUInt()){
-      throw std::string("value "+name+" is expected to be an integer");
+    if (!from.isUInt() || from.asUInt() > std::numeric_limits<uint8_t>::max()){
+      throw std::string("value " + path.str() + " is expected to be an integer");
     }
     
     dest = static_cast<uint8_t>(from.asUInt());
   }
   
-  void extract(const ValueType& from, const std::string& name, int16_t& dest) const{
+  void extract(const ValueType& from, const icfg::ValuePath& path, int16_t& dest) const{
     
-    if (!from.isInt()){
-      throw std::string("value "+name+" is expected to be an integer");
+    if (!from.isInt() || from.asInt() < std::numeric_limits<int16_t>::min() || from.asInt() > std::numeric_limits<int16_t>::max()){
+      throw std::string("value " + path.str() + " is expected to be an integer");
     }
     
     dest = static_cast<int16_t>(from.asInt());
   }
   
-  void extract(const ValueType& from, const std::string& name, uint16_t& dest) const{
+  void extract(const ValueType& from, const icfg::ValuePath& path, uint16_t& dest) const{
     
-    if (!from.isUInt()){
-      throw std::string("value "+name+" is expected to be an integer");
+    if (!from.isUInt() || from.asUInt() > std::numeric_limits<uint16_t>::max()){
+      throw std::string("value " + path.str() + " is expected to be an integer");
     }
     
     dest = static_cast<uint16_t>(from.asUInt());
   }
   
-  void extract(const ValueType& from, const std::string& name, int32_t& dest) const{
+  void extract(const ValueType& from, const icfg::ValuePath& path, int32_t& dest) const{
     
     if (!from.isInt()){
-      throw std::string("value "+name+" is expected to be an integer");
+      throw std::string("value " + path.str() + " is expected to be an integer");
     }
     
     dest = static_cast<int32_t>(from.asInt());
   }
   
-  void extract(const ValueType& from, const std::string& name, uint32_t& dest) const{
+  void extract(const ValueType& from, const icfg::ValuePath& path, uint32_t& dest) const{
     
     if (!from.isUInt()){
-      throw std::string("value "+name+" is expected to be a string");
+      throw std::string("value " + path.str() + " is expected to be a string");
     }
     
     dest = static_cast<uint32_t>(from.asUInt());
   }
   
-  void extract(const ValueType& from, const std::string& name, int64_t& dest) const{
+  void extract(const ValueType& from, const icfg::ValuePath& path, int64_t& dest) const{
     
     if (!from.isInt64()){
-      throw std::string("value "+name+" is expected to be a string");
+      throw std::string("value " + path.str() + " is expected to be a string");
     }
     
     dest = static_cast<int64_t>(from.asInt64());
   }
   
-  void extract(const ValueType& from, const std::string& name, uint64_t& dest) const{
+  void extract(const ValueType& from, const icfg::ValuePath& path, uint64_t& dest) const{
     
     if (!from.isUInt64()){
-      throw std::string("value "+name+" is expected to be an integer");
+      throw std::string("value " + path.str() + " is expected to be an integer");
     }
     
     dest = static_cast<uint64_t>(from.asUInt64());
   }
   
-  void extract(const ValueType& from, const std::string& name, float& dest) const{
+  void extract(const ValueType& from, const icfg::ValuePath& path, float& dest) const{
     
     if (!from.isDouble()){
-      throw std::string("value "+name+" is expected to be a string");
+      throw std::string("value " + path.str() + " is expected to be a string");
     }
     
     dest = from.asFloat();
   }
   
-  void extract(const ValueType& from, const std::string& name, double& dest) const{
+  void extract(const ValueType& from, const icfg::ValuePath& path, double& dest) const{
     
     if (!from.isDouble()){
-      throw std::string("value "+name+" is expected to be a double");
+      throw std::string("value " + path.str() + " is expected to be a double");
     }
     
     dest = from.asDouble();
   }
   
   template <typename ValueT>
-  void extract(const ValueType& from, const std::string& name, std::vector<ValueT>& dest) const {
+  void extract(const ValueType& from, const icfg::ValuePath& path, std::vector<ValueT>& dest) const {
 	  
 	  if (!from.isArray()) {
-		  throw std::string("value " + name + " is expected to be an array");
+		  throw std::string("value " + path.str() + " is expected to be an array");
 	  }
 
-	  for (size_t i = 0; i<from.size(); ++i) {
-		  ValueT outputValue;
-		  extract(from[i], name + "[" + std::to_string(i) + "]", outputValue);
-		  dest.push_back(outputValue);
-	  }
+	  extractElements(from, path, dest, typename icfg::internal::ElementsKind<ValueT>::type());
   }
   
 private:
+  static void locateIn(const std::string& fileName, const ValueType& root, std::vector<icfg::ConfigError>& errors){
+    std::vector<std::ptrdiff_t> offsets(errors.size());
+    std::ptrdiff_t last = 0;
+    for (std::size_t i = 0; i < errors.size(); ++i){
+      //deepest member of the path found in the document
+      const ValueType* value = &root;
+      std::vector<std::string> names = errors[i].getPathNames();
+      for (std::size_t n = 0; n < names.size() && value->isObject() && value->isMember(names[n]); ++n){
+        value = &(*value)[names[n]];
+      }
+      offsets[i] = value->getOffsetStart();
+      last = std::max(last, offsets[i]);
+    }
+    
+    std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+    std::string content(static_cast<std::size_t>(last), '\0');
+    file.read(&content[0], last);
+    content.resize(static_cast<std::size_t>(file.gcount()));
+    
+    std::vector<std::size_t> lineStarts(1, 0);
+    for (std::size_t c = 0; c < content.size(); ++c){
+      if (content[c] == '\n'){
+        lineStarts.push_back(c + 1);
+      }
+    }
+    
+    const std::shared_ptr<const std::string> sharedFileName = std::make_shared<const std::string>(fileName);
+    for (std::size_t i = 0; i < errors.size(); ++i){
+      const std::size_t offset = static_cast<std::size_t>(offsets[i]);
+      if (offsets[i] < 0 || offset > content.size()){
+        continue;
+      }
+      const std::size_t line = std::upper_bound(lineStarts.begin(), lineStarts.end(), offset) - lineStarts.begin();
+      errors[i].setLocation(sharedFileName, line, offset - lineStarts[line - 1] + 1);
+    }
+  }
+  
+  template <typename ValueT>
+  void extractElements(const ValueType& from, const icfg::ValuePath& path, std::vector<ValueT>& dest, icfg::internal::genericElementsTag) const {
+    
+    dest.reserve(dest.size() + from.size());
+    for (Json::ArrayIndex i = 0; i<from.size(); ++i) {
+      ValueT outputValue;
+      extract(from[i], icfg::ValuePath(path, i), outputValue);
+      dest.push_back(outputValue);
+    }
+  }
+  
+  //integers are narrowed straight into the list, their range being checked once for the whole list
+  template <typename ValueT>
+  void extractElements(const ValueType& from, const icfg::ValuePath& path, std::vector<ValueT>& dest, icfg::internal::integerElementsTag) const {
+    
+    const std::size_t first = dest.size();
+    dest.resize(first + from.size());
+    
+    icfg::internal::IntegerBounds<ValueT> bounds;
+    bool allIntegers = true;
+    for (Json::ArrayIndex i = 0; i<from.size(); ++i) {
+      const ValueType& element = from[i];
+      if (element.type() == Json::uintValue){
+        unsigned long long value = element.asLargestUInt();
+        bounds.add(value);
+        dest[first + i] = static_cast<ValueT>(value);
+      }
+      else if (element.type() == Json::intValue){
+        long long value = element.asLargestInt();
+        bounds.add(value);
+        dest[first + i] = static_cast<ValueT>(value);
+      }
+      else {
+        allIntegers = false;
+      }
+    }
+    
+    if (!allIntegers || !bounds.fits()){
+      dest.resize(first);
+      //the element by element path reports the faulty element
+      extractElements(from, path, dest, icfg::internal::genericElementsTag());
+    }
+  }
+  
+  template <typename ValueT>
+  void extractElements(const ValueType& from, const icfg::ValuePath& path, std::vector<ValueT>& dest, icfg::internal::floatingElementsTag) const {
+    
+    const std::size_t first = dest.size();
+    dest.resize(first + from.size());
+    
+    bool allFloating = true;
+    for (Json::ArrayIndex i = 0; i<from.size(); ++i) {
+      const ValueType& element = from[i];
+      if (element.isDouble()){
+        dest[first + i] = static_cast<ValueT>(element.asDouble());
+      }
+      else {
+        allFloating = false;
+      }
+    }
+    
+    if (!allFloating){
+      dest.resize(first);
+      extractElements(from, path, dest, icfg::internal::genericElementsTag());
+    }
+  }
+  
+  void parse(const char* data, std::size_t length, const std::string& source){
+    Json::Reader reader;
+    bool success = reader.parse(data, data + length, mRoot);
+    
+    if (!success){
+      throw std::string("parse error in "+source + " : "+reader.getFormattedErrorMessages());
+    }
+  }
+  
+  //source of the document, to locate errors ; empty when not read from a file
+  std::string mFileName;
   Json::Value mRoot;
 
 };
@@ -17,6 +17,7 @@
     } else if (lChildPid==0){
       close(lPipes[0]);
       dup2(lPipes[1], STDOUT_FILENO);
+      dup2(lPipes[1], STDERR_FILENO);
       chdir(TestProjectLocation);
       execlp(CmakeExecutable, CmakeExecutable, "--build", ".", "--clean-first", "--target", testName.c_str(), (char*)NULL);
       
@@ -183,6 +183,20 @@ TEST_F(CompilerOutputTest, D13_SettingDisallowedParameterSetting){
   output_result_if_failed(std::get<1>(testResult));
 }
 
+TEST_F(CompilerOutputTest, D14_SettingDisallowedParameterRangeString){
+  auto testResult = build_test(std::string("D14_SettingDisallowedParameterRangeString"));
+  
+  EXPECT_TRUE(CompilerOutputTest::build_fails_with(testResult, "range is not a valid constraint for string setting types."));
+  output_result_if_failed(std::get<1>(testResult));
+}
+
+TEST_F(CompilerOutputTest, D15_SettingDisallowedParameterMatchesNumber){
+  auto testResult = build_test(std::string("D15_SettingDisallowedParameterMatchesNumber"));
+  
+  EXPECT_TRUE(CompilerOutputTest::build_fails_with(testResult, "matches is only a valid constraint for string setting types."));
+  output_result_if_failed(std::get<1>(testResult));
+}
+
 TEST_F(CompilerOutputTest, E1_switchOnAllowedParameters){
   auto testResult = build_test(std::string("E1_switchOnAllowedParameters"));
   
@@ -345,7 +359,10 @@ TEST_F(CompilerOutputTest, G7_checkUniqueName){
   output_result_if_failed(std::get<1>(testResult));
 }
 
-
-
-
+TEST_F(CompilerOutputTest, G8_checkNotCallable){
+  auto testResult = build_test(std::string("G8_checkNotCallable"));
+  
+  EXPECT_TRUE(CompilerOutputTest::build_fails_with(testResult, "missing required functor parameter in check function"));
+  output_result_if_failed(std::get<1>(testResult));
+}
 
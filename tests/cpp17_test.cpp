@@ -0,0 +1,129 @@
+/*
+  The std::string_view lookups only exist from C++17, while the test suite
+  builds as C++11 : they are checked here, with instantConfig.h alone and
+  without gtest
+*/
+#include "instantConfig.h"
+
+#include <iostream>
+
+#if __cplusplus < 201703L
+#error "this test checks the C++17 lookups, build it with -std=c++17"
+#endif
+
+using namespace icfg;
+
+namespace{
+
+  //a document held in memory, enough for maps of scores
+  struct MemoryValue{
+    std::map<std::string, std::shared_ptr<const MemoryValue>> children;
+    uint32_t score;
+  };
+
+  class MemoryLoader{
+
+  public:
+    typedef MemoryValue ValueType;
+
+    explicit MemoryLoader(ValueType root)
+    : mRoot(std::move(root)){}
+
+    const ValueType& getRoot() const {
+      return mRoot;
+    }
+
+    bool hasValue(const ValueType& from, const std::string& settingName) const {
+      return from.children.count(settingName) != 0;
+    }
+
+    template <typename Callback>
+    void forEachChild(const ValueType& from, Callback&& callback) const{
+      for (const auto& child : from.children){
+        callback(child.first, *child.second);
+      }
+    }
+
+    const ValueType& getContainedValue(const ValueType& from, const std::string& name) const{
+      return *from.children.at(name);
+    }
+
+    void getValue(const ValueType& parent, const std::string& name, uint32_t& dest) const {
+      dest = getContainedValue(parent, name).score;
+    }
+
+  private:
+    ValueType mRoot;
+  };
+
+  std::shared_ptr<const MemoryValue> Scores(){
+    auto players = std::make_shared<MemoryValue>();
+    const char* names[] = {"alice", "bob", "carol"};
+    for (uint32_t i = 0; i < 3; ++i){
+      auto score = std::make_shared<MemoryValue>();
+      score->score = i + 1;
+      auto player = std::make_shared<MemoryValue>();
+      player->children["Score"] = score;
+      players->children[names[i]] = player;
+    }
+    return players;
+  }
+
+  int failures = 0;
+
+  void Check(bool condition, const char* what){
+    if (!condition){
+      std::cerr << "failed : " << what << std::endl;
+      ++failures;
+    }
+  }
+
+}
+
+#define ICFG_CHECK(CONDITION) Check(CONDITION, #CONDITION)
+
+int main(){
+  auto def =
+  config(
+    map(ICFG_STR("Flat"), flat_storage,
+      setting(ICFG_STR("Score"), uint32)
+    ),
+    map(ICFG_STR("Frozen"), frozen_storage,
+      setting(ICFG_STR("Score"), uint32)
+    )
+  );
+
+  MemoryValue root;
+  root.children["Flat"] = Scores();
+  root.children["Frozen"] = Scores();
+  auto result = def.load(MemoryLoader(root));
+  ICFG_CHECK(!result.hasError());
+
+  //views into a longer text, that a lookup can't take for a C string
+  const std::string_view text("bob and alice");
+  const std::string_view bob = text.substr(0, 3);
+  const std::string_view alice = text.substr(8);
+  const std::string_view dave("dave");
+
+  const auto& flat = result.get(ICFG_STR("Flat"));
+  ICFG_CHECK(flat.count(bob) == 1);
+  ICFG_CHECK(flat.count(dave) == 0);
+  ICFG_CHECK(flat.at(alice).get(ICFG_STR("Score")) == 1);
+  ICFG_CHECK(flat.find(bob)->second.get(ICFG_STR("Score")) == 2);
+
+  const auto& frozen = result.get(ICFG_STR("Frozen"));
+  ICFG_CHECK(frozen.find(bob) != frozen.end());
+  ICFG_CHECK(frozen.find(bob)->second.get(ICFG_STR("Score")) == 2);
+  ICFG_CHECK(frozen.find(alice)->second.get(ICFG_STR("Score")) == 1);
+  ICFG_CHECK(frozen.find(dave) == frozen.end());
+  ICFG_CHECK(frozen.find(text) == frozen.end());
+
+  hash_set<std::string> tags;
+  tags.insert("bob");
+  tags.insert("carol");
+  ICFG_CHECK(tags.contains(bob));
+  ICFG_CHECK(!tags.contains(alice));
+  ICFG_CHECK(!tags.contains(text));
+
+  return failures == 0 ? 0 : 1;
+}
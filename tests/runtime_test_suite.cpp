@@ -0,0 +1,1076 @@
+#include "gtest/gtest.h"
+
+#include "instantConfig.h"
+#include "jsoncons_icfg_loader.h"
+#include "jsoncons_tape_icfg_loader.h"
+#include "jsoncons_pipelined_icfg_loader.h"
+#ifdef ICFG_TEST_JSONCPP
+#include "jsoncpp_icfg_loader.h"
+#endif
+
+#include <fstream>
+#include <thread>
+
+using namespace icfg;
+
+/**
+Helpers
+*/
+
+static std::string write_test_config(const std::string& pName, const std::string& pContent){
+  std::string lFileName = std::string("runtime_") + pName + ".json";
+  std::ofstream lFile(lFileName.c_str());
+  lFile << pContent;
+  return lFileName;
+}
+
+/**
+Map
+*/
+
+TEST(RuntimeTest, MapLoadsEveryMember){
+  auto def = 
+  config(
+    map(ICFG_STR("Players"),
+      setting(ICFG_STR("Score"), uint32)
+    )
+  );
+  
+  jsoncons_loader loader(write_test_config("MapLoadsEveryMember", "{\"Players\":{\"bob\":{\"Score\":3},\"alice\":{\"Score\":7}}}"));
+  auto result = def.load(loader);
+  
+  ASSERT_FALSE(result.hasError());
+  auto& players = result.get(ICFG_STR("Players"));
+  ASSERT_EQ(2u, players.size());
+  EXPECT_EQ(3u, players["bob"].get(ICFG_STR("Score")));
+  EXPECT_EQ(7u, players["alice"].get(ICFG_STR("Score")));
+}
+
+//whether code outside the loader may append to a map
+template <typename MapT>
+struct can_append{
+  typedef char yes[1];
+  typedef char no[2];
+
+  template <typename M>
+  static yes& test(decltype(std::declval<M&>().append(std::string()), void())*);
+
+  template <typename>
+  static no& test(...);
+
+  static const bool value = sizeof(test<MapT>(0)) == sizeof(yes);
+};
+
+TEST(RuntimeTest, MapStoragesFindEveryKey){
+  auto flatDef =
+  config(
+    map(ICFG_STR("Players"), flat_storage,
+      setting(ICFG_STR("Score"), uint32, range<0,1000>())
+    )
+  );
+  auto frozenDef =
+  config(
+    map(ICFG_STR("Players"), frozen_storage,
+      setting(ICFG_STR("Score"), uint32, range<0,1000>())
+    )
+  );
+
+  std::string players = "{\"bob\":{\"Score\":3},\"alice\":{\"Score\":7}";
+  for (int i = 0; i < 500; ++i){
+    players += ",\"player" + std::to_string(i) + "\":{\"Score\":" + std::to_string(i) + "}";
+  }
+  players += "}";
+  std::string fileName = write_test_config("MapStoragesFindEveryKey", "{\"Players\":" + players + "}");
+
+  auto flat = flatDef.load(jsoncons_loader(fileName));
+  auto frozen = frozenDef.load(jsoncons_loader(fileName));
+  ASSERT_FALSE(flat.hasError());
+  ASSERT_FALSE(frozen.hasError());
+
+  const auto& flatPlayers = flat.get(ICFG_STR("Players"));
+  const auto& frozenPlayers = frozen.get(ICFG_STR("Players"));
+  ASSERT_EQ(502u, flatPlayers.size());
+  ASSERT_EQ(502u, frozenPlayers.size());
+  //entries are sorted by key
+  EXPECT_EQ("alice", flatPlayers.begin()->first);
+  EXPECT_EQ(3u, flatPlayers["bob"].get(ICFG_STR("Score")));
+  EXPECT_EQ(3u, frozenPlayers["bob"].get(ICFG_STR("Score")));
+  for (int i = 0; i < 500; ++i){
+    std::string key = "player" + std::to_string(i);
+    ASSERT_EQ(1u, frozenPlayers.count(key.c_str()));
+    EXPECT_EQ(static_cast<uint32_t>(i), frozenPlayers.at(key).get(ICFG_STR("Score")));
+    EXPECT_EQ(static_cast<uint32_t>(i), flatPlayers.at(key).get(ICFG_STR("Score")));
+  }
+  EXPECT_EQ(7u, flatPlayers.find("alice and bob", 5)->second.get(ICFG_STR("Score")));
+  EXPECT_EQ(7u, frozenPlayers.find("alice and bob", 5)->second.get(ICFG_STR("Score")));
+  EXPECT_TRUE(flatPlayers.find("carol") == flatPlayers.end());
+  EXPECT_TRUE(frozenPlayers.find("carol") == frozenPlayers.end());
+  EXPECT_THROW(frozenPlayers.at("carol"), std::out_of_range);
+#if __cplusplus >= 201703L
+  EXPECT_EQ(7u, flatPlayers.find(std::string_view("alice and bob").substr(0, 5))->second.get(ICFG_STR("Score")));
+  EXPECT_EQ(7u, frozenPlayers.at(std::string_view("alice")).get(ICFG_STR("Score")));
+#endif
+  //keys can't be changed through the iterators, which would break the lookups
+  static_assert(std::is_const<std::remove_reference<decltype(*std::declval<flat_map<int>&>().begin())>::type>::value, "flat_map entries are read-only");
+  
+  //only the loader fills a map
+  static_assert(!can_append<flat_map<int>>::value && !can_append<frozen_map<int>>::value, "maps are filled by the loader only");
+  
+  //a table left without its perfect hash, as when keys share their hash, is searched as a flat_map
+  frozen_map<int> unhashed;
+  EXPECT_EQ(0u, unhashed.count("carol"));
+
+  auto invalid = frozenDef.load(jsoncons_loader(write_test_config("MapStoragesFindEveryKey", "{\"Players\":{\"bob\":{\"Score\":3000}}}")));
+  ASSERT_EQ(1u, invalid.getErrors().size());
+  EXPECT_EQ("Players.bob.Score", invalid.getErrors()[0].getPath());
+  EXPECT_EQ(std::vector<std::string>({"Players", "bob", "Score"}), invalid.getErrors()[0].getPathNames());
+}
+
+/**
+List
+*/
+
+TEST(RuntimeTest, ListElementErrorNamesTheElement){
+  auto def = 
+  config(
+    setting(ICFG_STR("Values"), list(uint32))
+  );
+  
+  jsoncons_loader loader(write_test_config("ListElementErrorNamesTheElement", "{\"Values\":[1,\"two\",3]}"));
+  
+  try{
+    def.load(loader);
+    FAIL() << "loading a mistyped list element should fail";
+  } catch (const std::string& error){
+    EXPECT_NE(std::string::npos, error.find("Values[1]"));
+  }
+}
+
+
+/**
+Numeric list
+*/
+
+TEST(RuntimeTest, NumericListConvertsEveryElement){
+  auto def = 
+  config(
+    setting(ICFG_STR("Ports"), list(uint16)),
+    setting(ICFG_STR("Weights"), list(float32))
+  );
+  
+  jsoncons_loader loader(write_test_config("NumericListConvertsEveryElement", "{\"Ports\":[80,443,65535],\"Weights\":[0.5,1.25]}"));
+  auto result = def.load(loader);
+  
+  ASSERT_EQ(3u, result.get(ICFG_STR("Ports")).size());
+  EXPECT_EQ(65535, result.get(ICFG_STR("Ports"))[2]);
+  ASSERT_EQ(2u, result.get(ICFG_STR("Weights")).size());
+  EXPECT_FLOAT_EQ(1.25f, result.get(ICFG_STR("Weights"))[1]);
+}
+
+TEST(RuntimeTest, OutOfRangeListElementIsNamed){
+  auto def = 
+  config(
+    setting(ICFG_STR("Ports"), list(uint16))
+  );
+  
+  jsoncons_loader loader(write_test_config("OutOfRangeListElementIsNamed", "{\"Ports\":[80,65536,443]}"));
+  
+  try{
+    def.load(loader);
+    FAIL() << "loading an out of range list element should fail";
+  } catch (const std::string& error){
+    EXPECT_NE(std::string::npos, error.find("Ports[1]"));
+  }
+}
+
+/**
+Fixed-capacity types
+*/
+
+TEST(RuntimeTest, FixedStringsAreStoredInPlace){
+  auto def =
+  config(
+    setting(ICFG_STR("Id"), fixed_string<8>(), matches("[a-z]+")),
+    setting(ICFG_STR("Label"), fixed_string<4>()),
+    setting(ICFG_STR("Mode"), fixed_string<16>(), oneOf("windowed", "fullscreen"), length>=8)
+  );
+
+  auto valid = def.load(jsoncons_loader(write_test_config("FixedStringsAreStoredInPlace", "{\"Id\":\"player\", \"Label\":\"abcd\", \"Mode\":\"windowed\"}")));
+  static_assert(std::is_same<inline_string<8>, std::decay<decltype(valid.get(ICFG_STR("Id")))>::type>::value, "a fixed_string setting binds to an inline_string");
+  EXPECT_FALSE(valid.hasError());
+  EXPECT_EQ("player", valid.get(ICFG_STR("Id")));
+  EXPECT_EQ(std::string("abcd"), valid.get(ICFG_STR("Label")).str());
+  EXPECT_EQ(8u, valid.get(ICFG_STR("Mode")).size());
+
+  auto invalid = def.load(jsoncons_loader(write_test_config("FixedStringsAreStoredInPlace", "{\"Id\":\"Player\", \"Label\":\"abcde\", \"Mode\":\"tiled\"}")));
+  ASSERT_EQ(3u, invalid.getErrors().size());
+  EXPECT_EQ(error_code::pattern_constraint, invalid.getErrors()[0].code());
+  EXPECT_EQ(error_code::length_constraint, invalid.getErrors()[1].code());
+  EXPECT_EQ("Label", invalid.getErrors()[1].getPath());
+  EXPECT_EQ("Length constraint failed : size must be less or equal to 4, actual is 5", invalid.getErrors()[1].what());
+  EXPECT_EQ("Choice constraint failed : value must be one of \"windowed\", \"fullscreen\", actual is \"tiled\"", invalid.getErrors()[2].what());
+}
+
+TEST(RuntimeTest, ArraysHoldExactlyTheirSize){
+  auto def =
+  config(
+    setting(ICFG_STR("Color"), array<3>(uint8)),
+    setting(ICFG_STR("Weights"), array<4>(float32), range(0.0, 1.0)),
+    setting(ICFG_STR("Cores"), array<2>(int32), unique, sorted)
+  );
+
+  auto valid = def.load(jsoncons_loader(write_test_config("ArraysHoldExactlyTheirSize", "{\"Color\":[255,128,0], \"Weights\":[0.5,0.25,0.125,1.0], \"Cores\":[0,2]}")));
+  static_assert(std::is_same<std::array<uint8_t, 3>, std::decay<decltype(valid.get(ICFG_STR("Color")))>::type>::value, "an array setting binds to a std::array");
+  ASSERT_FALSE(valid.hasError());
+  EXPECT_EQ(128, valid.get(ICFG_STR("Color"))[1]);
+  EXPECT_FLOAT_EQ(0.125f, valid.get(ICFG_STR("Weights"))[2]);
+
+  auto invalid = def.load(jsoncons_loader(write_test_config("ArraysHoldExactlyTheirSize", "{\"Color\":[255,128], \"Weights\":[0.5,0.25,1.5,1.0], \"Cores\":[2,2]}")));
+  ASSERT_EQ(3u, invalid.getErrors().size());
+  EXPECT_EQ(error_code::length_constraint, invalid.getErrors()[0].code());
+  EXPECT_EQ("Length constraint failed : size must be equal 3, actual is 2", invalid.getErrors()[0].what());
+  EXPECT_EQ("Range constraint failed : element 2 must be between 0.000000 and 1.000000, actual is 1.500000", invalid.getErrors()[1].what());
+  EXPECT_EQ(error_code::uniqueness_constraint, invalid.getErrors()[2].code());
+}
+
+/**
+Set
+*/
+
+TEST(RuntimeTest, SetsAnswerMembershipAndRejectDuplicates){
+  auto def =
+  config(
+    setting(ICFG_STR("Allowed"), set(string)),
+    setting(ICFG_STR("Ports"), set(uint16), range<1024,65535>(), length<=8)
+  );
+
+  std::string hosts = "[";
+  for (int i = 0; i < 100; ++i){
+    hosts += (i == 0 ? "\"host" : ",\"host") + std::to_string(i) + "\"";
+  }
+  hosts += "]";
+  auto valid = def.load(jsoncons_loader(write_test_config("SetsAnswerMembershipAndRejectDuplicates", "{\"Allowed\":" + hosts + ", \"Ports\":[8080,8443]}")));
+  ASSERT_FALSE(valid.hasError());
+  const auto& allowed = valid.get(ICFG_STR("Allowed"));
+  ASSERT_EQ(100u, allowed.size());
+  for (int i = 0; i < 100; ++i){
+    EXPECT_TRUE(allowed.contains("host" + std::to_string(i)));
+  }
+  EXPECT_TRUE(allowed.contains("host42"));
+  EXPECT_TRUE(allowed.contains("host42 and more", 6));
+  EXPECT_FALSE(allowed.contains("host100"));
+#if __cplusplus >= 201703L
+  EXPECT_TRUE(allowed.contains(std::string_view("host42 and more").substr(0, 6)));
+  EXPECT_FALSE(allowed.contains(std::string_view("host100")));
+#endif
+  EXPECT_EQ("host0", allowed[0]);
+  EXPECT_EQ(1u, valid.get(ICFG_STR("Ports")).count(8443));
+  EXPECT_EQ(0u, valid.get(ICFG_STR("Ports")).count(80));
+
+  auto invalid = def.load(jsoncons_loader(write_test_config("SetsAnswerMembershipAndRejectDuplicates", "{\"Allowed\":[\"a\",\"b\",\"a\",\"b\"], \"Ports\":[8080,80]}")));
+  ASSERT_EQ(3u, invalid.getErrors().size());
+  EXPECT_EQ("Uniqueness constraint failed : elements 0 and 2 are both \"a\"", invalid.getErrors()[0].what());
+  EXPECT_EQ("Uniqueness constraint failed : elements 1 and 3 are both \"b\"", invalid.getErrors()[1].what());
+  EXPECT_EQ("Allowed", invalid.getErrors()[1].getPath());
+  EXPECT_EQ(error_code::range_constraint, invalid.getErrors()[2].code());
+}
+
+/**
+Arena loader
+*/
+
+TEST(RuntimeTest, ArenaLoaderLoadsLikeTheHeapLoader){
+  auto def = 
+  config(
+    setting(ICFG_STR("Name"), string),
+    setting(ICFG_STR("Ports"), list(uint16)),
+    map(ICFG_STR("Players"),
+      setting(ICFG_STR("Score"), uint32)
+    )
+  );
+  
+  arena_jsoncons_loader loader(write_test_config("ArenaLoaderLoadsLikeTheHeapLoader", "{\"Name\":\"a name long enough to leave the small string buffer\",\"Ports\":[80,443],\"Players\":{\"bob\":{\"Score\":3}}}"));
+  auto result = def.load(loader);
+  
+  ASSERT_FALSE(result.hasError());
+  EXPECT_EQ("a name long enough to leave the small string buffer", result.get(ICFG_STR("Name")));
+  ASSERT_EQ(2u, result.get(ICFG_STR("Ports")).size());
+  EXPECT_EQ(443, result.get(ICFG_STR("Ports"))[1]);
+  EXPECT_EQ(3u, result.get(ICFG_STR("Players"))["bob"].get(ICFG_STR("Score")));
+}
+
+TEST(RuntimeTest, ArenaAllocatorFreesNodesOutsideTheirScope){
+  json_arena arena;
+  arena_allocator<int> allocator;
+
+  int* fromHeap = allocator.allocate(4);
+  int* fromArena = nullptr;
+  {
+    json_arena::scope scope(arena);
+    fromArena = allocator.allocate(4);
+    EXPECT_TRUE(arena.owns(fromArena));
+    EXPECT_FALSE(arena.owns(fromHeap));
+
+    //heap memory is deleted even though an arena is current
+    allocator.deallocate(fromHeap, 4);
+  }
+
+  //arena memory isn't handed to the heap once its scope is over
+  EXPECT_TRUE(json_arena::anyOwns(fromArena));
+  allocator.deallocate(fromArena, 4);
+
+  json_arena other;
+  {
+    json_arena::scope scope(other);
+    allocator.deallocate(fromArena, 4);
+  }
+}
+
+/**
+Consume mode
+*/
+
+TEST(RuntimeTest, ConsumedLoaderStillBindsEverySetting){
+  auto def = 
+  config(
+    setting(ICFG_STR("Name"), string),
+    setting(ICFG_STR("Ports"), list(uint16))
+  );
+  
+  std::string fileName = write_test_config("ConsumedLoaderStillBindsEverySetting", "{\"Name\":\"server\",\"Ports\":[80,443]}");
+  arena_jsoncons_loader loader(fileName);
+  auto result = def.load(std::move(loader));
+  
+  ASSERT_FALSE(result.hasError());
+  EXPECT_EQ("server", result.get(ICFG_STR("Name")));
+  ASSERT_EQ(2u, result.get(ICFG_STR("Ports")).size());
+  
+  auto resultFromTemporary = def.load(jsoncons_loader(fileName));
+  ASSERT_FALSE(resultFromTemporary.hasError());
+  EXPECT_EQ(443, resultFromTemporary.get(ICFG_STR("Ports"))[1]);
+  
+  //heap loaders stay copyable next to their move constructor
+  jsoncons_loader heapLoader(fileName);
+  jsoncons_loader copiedLoader(heapLoader);
+  copiedLoader = heapLoader;
+  auto resultFromCopy = def.load(copiedLoader);
+  ASSERT_FALSE(resultFromCopy.hasError());
+  EXPECT_EQ("server", resultFromCopy.get(ICFG_STR("Name")));
+}
+
+/**
+Nested documents
+*/
+
+static std::string nested_node(int pDepth){
+  if (pDepth == 0){
+    return "{\"Leaf\":true}";
+  }
+  std::string lChild = nested_node(pDepth - 1);
+  return "{\"Values\":[1,2,3],\"Children\":[" + lChild + "," + lChild + "," + lChild + "]}";
+}
+
+TEST(RuntimeTest, DeeplyNestedDocumentLoads){
+  auto def = 
+  config(
+    setting(ICFG_STR("Name"), string)
+  );
+  
+  //each level of nesting used to copy the whole subtree below it several times
+  jsoncons_loader loader(write_test_config("DeeplyNestedDocumentLoads", "{\"Name\":\"tree\",\"Tree\":" + nested_node(9) + "}"));
+  auto result = def.load(loader);
+  
+  ASSERT_FALSE(result.hasError());
+  EXPECT_EQ("tree", result.get(ICFG_STR("Name")));
+}
+
+/**
+Subtree
+*/
+
+TEST(RuntimeTest, SubtreeBecomesTheRoot){
+  auto def = 
+  config(
+    setting(ICFG_STR("Width"), uint32),
+    setting(ICFG_STR("Height"), uint32)
+  );
+  
+  std::string fileName = write_test_config("SubtreeBecomesTheRoot", "{\"Audio\":{\"Width\":1},\"Graphics\":{\"Fullscreen\":true,\"Resolution\":{\"Width\":1920,\"Height\":1080}},\"Other\":[1,2]}");
+  auto result = def.load(jsoncons_loader(fileName, subtree("Graphics.Resolution")));
+  
+  ASSERT_FALSE(result.hasError());
+  EXPECT_EQ(1920u, result.get(ICFG_STR("Width")));
+  EXPECT_EQ(1080u, result.get(ICFG_STR("Height")));
+  
+  try{
+    jsoncons_loader loader(fileName, subtree("Graphics.Depth"));
+    FAIL() << "loading a missing subtree should fail";
+  } catch (const std::string& error){
+    EXPECT_NE(std::string::npos, error.find("Graphics.Depth"));
+  }
+}
+
+/**
+In place parsing
+*/
+
+TEST(RuntimeTest, FileShorterThanTheReadAheadLoads){
+  auto def = 
+  config(
+    setting(ICFG_STR("A"), int32)
+  );
+  
+  //shorter than the reader's look ahead : parsed from the padded tail buffer only
+  jsoncons_loader loader(write_test_config("FileShorterThanTheReadAheadLoads", "{\"A\":7}"));
+  auto result = def.load(loader);
+  
+  ASSERT_FALSE(result.hasError());
+  EXPECT_EQ(7, result.get(ICFG_STR("A")));
+}
+
+TEST(RuntimeTest, LoaderReadsBuffersAndDescriptors){
+  auto def = 
+  config(
+    setting(ICFG_STR("Name"), string),
+    setting(ICFG_STR("Port"), uint16)
+  );
+  
+  std::string content = "{\"Name\":\"in memory\",\"Port\":8080}";
+  auto fromBuffer = def.load(jsoncons_loader(buffer_view(content)));
+  ASSERT_FALSE(fromBuffer.hasError());
+  EXPECT_EQ("in memory", fromBuffer.get(ICFG_STR("Name")));
+  EXPECT_EQ(8080, fromBuffer.get(ICFG_STR("Port")));
+  
+#ifdef ICFG_JSONCONS_MMAP
+  //a pipe cannot be mapped : it is read until its end
+  int ends[2];
+  ASSERT_EQ(0, ::pipe(ends));
+  ASSERT_EQ(static_cast<ssize_t>(content.size()), ::write(ends[1], content.data(), content.size()));
+  ::close(ends[1]);
+  auto fromPipe = def.load(jsoncons_loader(file_descriptor(ends[0])));
+  ::close(ends[0]);
+  ASSERT_FALSE(fromPipe.hasError());
+  EXPECT_EQ(8080, fromPipe.get(ICFG_STR("Port")));
+#endif
+}
+
+#ifdef ICFG_TEST_JSONCPP
+TEST(RuntimeTest, JsoncppLoaderReadsBuffersAndDescriptors){
+  auto def = 
+  config(
+    setting(ICFG_STR("Name"), string),
+    setting(ICFG_STR("Port"), uint16)
+  );
+  
+  std::string content = "{\"Name\":\"in memory\",\"Port\":8080}";
+  auto fromBuffer = def.load(jsoncppLoader(buffer_view(content)));
+  ASSERT_FALSE(fromBuffer.hasError());
+  EXPECT_EQ("in memory", fromBuffer.get(ICFG_STR("Name")));
+  EXPECT_EQ(8080, fromBuffer.get(ICFG_STR("Port")));
+  
+#ifdef ICFG_JSONCPP_FILE_DESCRIPTOR
+  int ends[2];
+  ASSERT_EQ(0, ::pipe(ends));
+  ASSERT_EQ(static_cast<ssize_t>(content.size()), ::write(ends[1], content.data(), content.size()));
+  ::close(ends[1]);
+  auto fromPipe = def.load(jsoncppLoader(file_descriptor(ends[0])));
+  ::close(ends[0]);
+  ASSERT_FALSE(fromPipe.hasError());
+  EXPECT_EQ("in memory", fromPipe.get(ICFG_STR("Name")));
+#endif
+}
+#endif
+
+/**
+Tape loader
+*/
+
+TEST(RuntimeTest, TapeLoaderDecodesOnlyBoundValues){
+  auto def = 
+  config(
+    setting(ICFG_STR("Name"), string),
+    setting(ICFG_STR("Ports"), list(uint16)),
+    section(ICFG_STR("Window"),
+      setting(ICFG_STR("Width"), int32)
+    ),
+    map(ICFG_STR("Players"),
+      setting(ICFG_STR("Score"), uint32)
+    )
+  );
+  
+  //the Unused member holds an invalid literal : it is never decoded
+  jsoncons_tape_loader loader(write_test_config("TapeLoaderDecodesOnlyBoundValues", "{\"Name\":\"caf\\u00e9\",\"Unused\":[1,{\"x\":tru}],\"Ports\":[80,443],\"Window\":{\"Width\":800},\"Players\":{\"bob\":{\"Score\":3}}}"));
+  auto result = def.load(loader);
+  
+  ASSERT_FALSE(result.hasError());
+  EXPECT_EQ("caf\xc3\xa9", result.get(ICFG_STR("Name")));
+  ASSERT_EQ(2u, result.get(ICFG_STR("Ports")).size());
+  EXPECT_EQ(800, result.get(ICFG_STR("Window")).get(ICFG_STR("Width")));
+  EXPECT_EQ(3u, result.get(ICFG_STR("Players"))["bob"].get(ICFG_STR("Score")));
+}
+
+TEST(RuntimeTest, TapeLoaderReportsStructuralErrors){
+  try{
+    jsoncons_tape_loader loader(write_test_config("TapeLoaderReportsStructuralErrors", "{\"Name\":\"server\",\n\"Ports\":[80,443}"));
+    FAIL() << "scanning a document with mismatched brackets should fail";
+  } catch (const std::string& error){
+    EXPECT_NE(std::string::npos, error.find("line 2"));
+  }
+  
+  //an embedded NUL is no value, nor the end of one : the scalar holding it fails once decoded
+  std::string fileName = write_test_config("TapeLoaderReportsStructuralErrors", std::string("{\"Port\":\0}", 10));
+  EXPECT_THROW(jsoncons_tape_loader loader(fileName), std::string);
+  EXPECT_THROW(jsoncons_tape_loader loader(fileName, parallel_scan(2)), std::string);
+  
+  auto def = config(setting(ICFG_STR("Port"), uint16));
+  fileName = write_test_config("TapeLoaderReportsStructuralErrors", std::string("{\"Port\":8\0}", 11));
+  EXPECT_ANY_THROW(def.load(jsoncons_tape_loader(fileName)));
+  EXPECT_ANY_THROW(def.load(jsoncons_tape_loader(fileName, parallel_scan(2))));
+}
+
+TEST(RuntimeTest, ParallelScanMatchesTheSequentialScan){
+  auto def = 
+  config(
+    setting(ICFG_STR("Name"), string),
+    map(ICFG_STR("Players"),
+      setting(ICFG_STR("Score"), uint32),
+      setting(ICFG_STR("Tag"), string)
+    )
+  );
+  
+  //large enough to be split in several chunks, with quotes and escapes on every chunk boundary candidate
+  std::string content = "{\"Name\":\"big\",\"Players\":{";
+  for (int i = 0; i < 60000; ++i){
+    content += (i == 0 ? "\"p" : ",\"p") + std::to_string(i) + "\":{\"Score\":" + std::to_string(i) + ",\"Tag\":\"a \\\"quoted\\\" \\\\ tag\"}";
+  }
+  content += "}}";
+  std::string fileName = write_test_config("ParallelScanMatchesTheSequentialScan", content);
+  
+  auto result = def.load(jsoncons_tape_loader(fileName, parallel_scan(4)));
+  
+  ASSERT_FALSE(result.hasError());
+  EXPECT_EQ("big", result.get(ICFG_STR("Name")));
+  ASSERT_EQ(60000u, result.get(ICFG_STR("Players")).size());
+  EXPECT_EQ(59999u, result.get(ICFG_STR("Players"))["p59999"].get(ICFG_STR("Score")));
+  EXPECT_EQ("a \"quoted\" \\ tag", result.get(ICFG_STR("Players"))["p31234"].get(ICFG_STR("Tag")));
+  
+  //the indexed scan records the very tape of the sequential scan
+  std::vector<internal::TapeEntry> sequentialTape;
+  internal::TapeScanner(content.data(), content.size(), fileName, sequentialTape).scan();
+  internal::StructuralIndex index;
+  ASSERT_TRUE(index.build(content.data(), content.size(), 4));
+  std::vector<internal::TapeEntry> parallelTape;
+  internal::TapeScanner(content.data(), content.size(), fileName, parallelTape, &index).scan();
+  
+  ASSERT_EQ(sequentialTape.size(), parallelTape.size());
+  for (std::size_t i = 0; i < sequentialTape.size(); ++i){
+    ASSERT_EQ(sequentialTape[i].kind, parallelTape[i].kind) << "entry " << i;
+    ASSERT_EQ(sequentialTape[i].escaped, parallelTape[i].escaped) << "entry " << i;
+    ASSERT_EQ(sequentialTape[i].begin, parallelTape[i].begin) << "entry " << i;
+    ASSERT_EQ(sequentialTape[i].end, parallelTape[i].end) << "entry " << i;
+    ASSERT_EQ(sequentialTape[i].next, parallelTape[i].next) << "entry " << i;
+  }
+}
+
+/**
+Pipelined loader
+*/
+
+TEST(RuntimeTest, PipelinedLoaderBindsMembersAcrossBlocks){
+  auto def = 
+  config(
+    setting(ICFG_STR("Name"), string),
+    setting(ICFG_STR("Last"), int32),
+    map(ICFG_STR("Players"),
+      setting(ICFG_STR("Score"), uint32)
+    )
+  );
+  
+  //several read blocks long, with the last setting bound at the very end of the file
+  std::string content = "{\"Name\":\"pipe\",\"Players\":{";
+  for (int i = 0; i < 100000; ++i){
+    content += (i == 0 ? "\"p" : ",\"p") + std::to_string(i) + "\":{\"Score\":" + std::to_string(i) + "}";
+  }
+  content += "},\"Last\":42}";
+  std::string fileName = write_test_config("PipelinedLoaderBindsMembersAcrossBlocks", content);
+  
+  auto result = def.load(jsoncons_pipelined_loader(fileName));
+  
+  ASSERT_FALSE(result.hasError());
+  EXPECT_EQ("pipe", result.get(ICFG_STR("Name")));
+  EXPECT_EQ(42, result.get(ICFG_STR("Last")));
+  ASSERT_EQ(100000u, result.get(ICFG_STR("Players")).size());
+  EXPECT_EQ(99999u, result.get(ICFG_STR("Players"))["p99999"].get(ICFG_STR("Score")));
+}
+
+TEST(RuntimeTest, PipelinedLoaderReportsSyntaxErrors){
+  auto def = 
+  config(
+    setting(ICFG_STR("Name"), string),
+    setting(ICFG_STR("Port"), int32)
+  );
+  
+  jsoncons_pipelined_loader loader(write_test_config("PipelinedLoaderReportsSyntaxErrors", "{\"Name\":\"pipe\",\"Port\" 80}"));
+  
+  try{
+    def.load(loader);
+    FAIL() << "binding a member past a syntax error should fail";
+  } catch (const std::string& error){
+    EXPECT_NE(std::string::npos, error.find("PipelinedLoaderReportsSyntaxErrors"));
+  }
+  
+  //the error lies past the last member bound : the load waits for the end of the parse
+  auto nameOnly = config(setting(ICFG_STR("Name"), string));
+  std::string fileName = write_test_config("PipelinedLoaderReportsSyntaxErrors", "{\"Name\":\"pipe\",\"Other\": [1,2,,,}");
+  EXPECT_ANY_THROW(nameOnly.load(jsoncons_loader(fileName)));
+  EXPECT_THROW(nameOnly.load(jsoncons_pipelined_loader(fileName)), std::string);
+  EXPECT_THROW(nameOnly.load(jsoncons_pipelined_loader(fileName), load_options().validation_threads(2)), std::string);
+}
+
+TEST(RuntimeTest, PushLoaderParsesChunksAsTheyArrive){
+  auto def = 
+  config(
+    setting(ICFG_STR("Name"), string),
+    setting(ICFG_STR("Ports"), list(uint16))
+  );
+  
+  //chunk boundaries falling within names, strings and numbers
+  std::string content = "{\"Name\":\"pushed \\\"name\\\"\",\"Ports\":[80,443,8080]}";
+  jsoncons_push_loader loader;
+  for (std::size_t i = 0; i < content.size(); i += 3){
+    loader.feed(content.data() + i, std::min<std::size_t>(3, content.size() - i));
+  }
+  loader.finish();
+  auto result = def.load(std::move(loader));
+  
+  ASSERT_FALSE(result.hasError());
+  EXPECT_EQ("pushed \"name\"", result.get(ICFG_STR("Name")));
+  ASSERT_EQ(3u, result.get(ICFG_STR("Ports")).size());
+  EXPECT_EQ(8080, result.get(ICFG_STR("Ports"))[2]);
+  
+  jsoncons_push_loader truncated("truncated document");
+  truncated.feed("{\"Name\":\"pushed\"");
+  EXPECT_THROW(truncated.finish(), std::string);
+  
+  //whitespace may follow the document, nothing else
+  jsoncons_push_loader padded("padded document");
+  padded.feed("{\"Name\":\"pushed\"} \n");
+  padded.feed("\t ");
+  EXPECT_NO_THROW(padded.finish());
+  
+  jsoncons_push_loader trailing("trailing document");
+  trailing.feed("{\"Name\":\"pushed\"} ");
+  try{
+    trailing.feed("garbage");
+    trailing.finish();
+    FAIL() << "data after the end of the document should be reported";
+  } catch (const std::string& error){
+    EXPECT_NE(std::string::npos, error.find("trailing document"));
+  }
+}
+
+/**
+Built-in constraints
+*/
+
+TEST(RuntimeTest, BuiltinConstraintsCheckValuesAndLists){
+  auto def = 
+  config(
+    setting(ICFG_STR("Volume"), int32, range<0,100>()),
+    setting(ICFG_STR("Ports"), list(uint16), range<1024,65535>(), unique),
+    setting(ICFG_STR("Gamma"), float32, range(0.5, 2.5)),
+    setting(ICFG_STR("Mode"), string, oneOf("windowed", "fullscreen")),
+    setting(ICFG_STR("Player"), string, matches("[a-z]+[0-9]*")),
+    setting(ICFG_STR("Levels"), list(int32), sorted),
+    setting(ICFG_STR("Tags"), list(string), unique)
+  );
+  
+  auto valid = def.load(jsoncons_loader(write_test_config("BuiltinConstraintsCheckValuesAndLists", "{\"Volume\":100,\"Ports\":[8080,8081],\"Gamma\":2.2,\"Mode\":\"windowed\",\"Player\":\"bob42\",\"Levels\":[1,1,3],\"Tags\":[\"a\",\"b\"]}")));
+  EXPECT_FALSE(valid.hasError());
+  
+  auto invalid = def.load(jsoncons_loader(write_test_config("BuiltinConstraintsCheckValuesAndLists", "{\"Volume\":-1,\"Ports\":[8080,80,8080],\"Gamma\":3.5,\"Mode\":\"borderless\",\"Player\":\"Bob\",\"Levels\":[1,3,2],\"Tags\":[\"a\",\"b\",\"a\"]}")));
+  //the constraints of a setting stop at the first failing one
+  ASSERT_EQ(7u, invalid.getErrors().size());
+  EXPECT_EQ("Volume", invalid.getErrors()[0].getFailingSettingName());
+  EXPECT_EQ("Range constraint failed : element 1 must be between 1024 and 65535, actual is 80", invalid.getErrors()[1].what());
+  EXPECT_EQ("Gamma", invalid.getErrors()[2].getFailingSettingName());
+  EXPECT_NE(std::string::npos, invalid.getErrors()[3].what().find("\"windowed\", \"fullscreen\""));
+  EXPECT_EQ("Player", invalid.getErrors()[4].getFailingSettingName());
+  EXPECT_EQ("Order constraint failed : element 2 is less than element 1, 2 < 3", invalid.getErrors()[5].what());
+  EXPECT_EQ("Uniqueness constraint failed : elements 0 and 2 are both \"a\"", invalid.getErrors()[6].what());
+}
+
+TEST(RuntimeTest, OneOfKeepsTheChoicesInTheirCommonType){
+  auto def = 
+  config(
+    setting(ICFG_STR("Scale"), float64, oneOf(1, 2.5))
+  );
+  
+  auto valid = def.load(jsoncons_loader(write_test_config("OneOfKeepsTheChoicesInTheirCommonType", "{\"Scale\":2.5}")));
+  EXPECT_FALSE(valid.hasError());
+  
+  auto invalid = def.load(jsoncons_loader(write_test_config("OneOfKeepsTheChoicesInTheirCommonType", "{\"Scale\":1.5}")));
+  ASSERT_EQ(1u, invalid.getErrors().size());
+  EXPECT_NE(std::string::npos, invalid.getErrors()[0].what().find("1.000000, 2.500000"));
+}
+
+/**
+Group constraints
+*/
+
+struct WidthBounds{
+  template <typename Group>
+  bool operator()(const Group& group) const{
+    return group.get(ICFG_STR("MinWidth")) < group.get(ICFG_STR("MaxWidth"));
+  }
+};
+
+struct ThreadsBelowCores{
+  template <typename Group>
+  bool operator()(const Group& group) const{
+    return group.get(ICFG_STR("Threads")) <= group.get(ICFG_STR("Cores"));
+  }
+};
+
+TEST(RuntimeTest, GroupConstraintsSeeTheBoundGroup){
+  auto def = 
+  config(
+    setting(ICFG_STR("Threads"), uint32),
+    setting(ICFG_STR("Cores"), uint32),
+    check(ICFG_STR("ThreadsBelowCores"), ThreadsBelowCores()),
+    section(ICFG_STR("Window"),
+      setting(ICFG_STR("MinWidth"), int32),
+      setting(ICFG_STR("MaxWidth"), int32),
+      check(ICFG_STR("WidthBounds"), WidthBounds())
+    ),
+    map(ICFG_STR("Panels"),
+      setting(ICFG_STR("MinWidth"), int32),
+      setting(ICFG_STR("MaxWidth"), int32),
+      check(ICFG_STR("WidthBounds"), WidthBounds())
+    )
+  );
+  
+  auto valid = def.load(jsoncons_loader(write_test_config("GroupConstraintsSeeTheBoundGroup", "{\"Threads\":4,\"Cores\":8,\"Window\":{\"MinWidth\":10,\"MaxWidth\":20},\"Panels\":{\"left\":{\"MinWidth\":1,\"MaxWidth\":2}}}")));
+  EXPECT_FALSE(valid.hasError());
+  
+  auto invalid = def.load(jsoncons_loader(write_test_config("GroupConstraintsSeeTheBoundGroup", "{\"Threads\":16,\"Cores\":8,\"Window\":{\"MinWidth\":30,\"MaxWidth\":20},\"Panels\":{\"left\":{\"MinWidth\":3,\"MaxWidth\":2}}}")));
+  ASSERT_EQ(3u, invalid.getErrors().size());
+  EXPECT_EQ("Window", invalid.getErrors()[0].getFailingSettingName());
+  EXPECT_EQ("Constraint validation \"WidthBounds\" failed.", invalid.getErrors()[0].what());
+  EXPECT_EQ("Panels[left]", invalid.getErrors()[1].getFailingSettingName());
+  EXPECT_EQ("Constraint validation \"ThreadsBelowCores\" failed.", invalid.getErrors()[2].what());
+  
+  //same outcome when the constraints are checked in a pass of their own
+  auto parallel = def.load(jsoncons_loader(write_test_config("GroupConstraintsSeeTheBoundGroup", "{\"Threads\":16,\"Cores\":8,\"Window\":{\"MinWidth\":30,\"MaxWidth\":20},\"Panels\":{\"left\":{\"MinWidth\":3,\"MaxWidth\":2}}}")), load_options().validation_threads(2));
+  EXPECT_EQ(3u, parallel.getErrors().size());
+  
+  //a group one setting of which is missing isn't checked : its value was never read
+  std::string missing = "{\"Threads\":16,\"Cores\":8,\"Window\":{\"MinWidth\":30},\"Panels\":{\"left\":{\"MinWidth\":3},\"right\":{\"MinWidth\":3,\"MaxWidth\":2}}}";
+  auto partial = def.load(jsoncons_loader(write_test_config("GroupConstraintsSeeTheBoundGroup", missing)));
+  ASSERT_EQ(3u, partial.getErrors().size());
+  EXPECT_EQ(error_code::missing_setting, partial.getErrors()[0].code());
+  EXPECT_EQ(error_code::missing_setting, partial.getErrors()[1].code());
+  EXPECT_EQ("Panels[right]", partial.getErrors()[2].getFailingSettingName());
+  
+  auto partialParallel = def.load(jsoncons_loader(write_test_config("GroupConstraintsSeeTheBoundGroup", missing)), load_options().validation_threads(2));
+  ASSERT_EQ(partial.getErrors().size(), partialParallel.getErrors().size());
+  for (std::size_t i = 0; i < partial.getErrors().size(); ++i){
+    EXPECT_EQ(partial.getErrors()[i].what(), partialParallel.getErrors()[i].what());
+  }
+}
+
+/**
+Error cap
+*/
+
+TEST(RuntimeTest, ErrorCapStopsTheLoad){
+  int checked = 0;
+  auto def = 
+  config(
+    map(ICFG_STR("Players"),
+      setting(ICFG_STR("Score"), uint32, check(ICFG_STR("ScoreBelowHundred"), [&checked](uint32_t score){ ++checked; return score < 100; }))
+    )
+  );
+  
+  std::string content = "{\"Players\":{";
+  for (int i = 0; i < 1000; ++i){
+    content += (i == 0 ? "\"p" : ",\"p") + std::to_string(i) + "\":{\"Score\":" + std::to_string(100 + i) + "}";
+  }
+  content += "}}";
+  jsoncons_loader loader(write_test_config("ErrorCapStopsTheLoad", content));
+  
+  EXPECT_EQ(1000u, def.load(loader).getErrors().size());
+  
+  checked = 0;
+  auto failFast = def.load(loader, load_options().fail_fast());
+  EXPECT_EQ(1u, failFast.getErrors().size());
+  EXPECT_EQ(1, checked);
+  
+  checked = 0;
+  auto capped = def.load(loader, load_options().max_errors(10));
+  EXPECT_EQ(10u, capped.getErrors().size());
+  EXPECT_EQ(10, checked);
+  
+  auto cappedParallel = def.load(loader, load_options().max_errors(10).validation_threads(4));
+  EXPECT_EQ(10u, cappedParallel.getErrors().size());
+}
+
+/**
+Error locations
+*/
+
+TEST(RuntimeTest, ErrorsCarryTheirPathAndLocation){
+  auto def = 
+  config(
+    section(ICFG_STR("Window"),
+      setting(ICFG_STR("Width"), int32, range<1,4096>())
+    ),
+    map(ICFG_STR("Players"),
+      setting(ICFG_STR("Score"), uint32)
+    )
+  );
+  
+  std::string fileName = write_test_config("ErrorsCarryTheirPathAndLocation", "{\n  \"Window\": {\n    \"Width\": -1\n  },\n  \"Players\": {\n    \"bob\": {}\n  }\n}");
+  auto result = def.load(jsoncons_loader(fileName));
+  
+  ASSERT_EQ(2u, result.getErrors().size());
+  EXPECT_EQ("Window.Width", result.getErrors()[0].getPath());
+  EXPECT_EQ(fileName, result.getErrors()[0].getFile());
+  EXPECT_EQ(3u, result.getErrors()[0].getLine());
+  //a missing setting is located at its parent
+  EXPECT_EQ("Players.bob.Score", result.getErrors()[1].getPath());
+  EXPECT_EQ(6u, result.getErrors()[1].getLine());
+  
+  //paths stay relative to the subtree, locations are in the whole file
+  auto windowDef = 
+  config(
+    setting(ICFG_STR("Width"), int32, range<1,4096>())
+  );
+  auto window = windowDef.load(jsoncons_loader(fileName, subtree("Window")));
+  ASSERT_EQ(1u, window.getErrors().size());
+  EXPECT_EQ("Width", window.getErrors()[0].getPath());
+  EXPECT_EQ(3u, window.getErrors()[0].getLine());
+}
+
+TEST(RuntimeTest, ErrorsAreSortedByCode){
+  auto def =
+  config(
+    setting(ICFG_STR("Name"), string, length>3, matches("[a-z]+")),
+    setting(ICFG_STR("Mode"), string, oneOf("windowed", "fullscreen")),
+    setting(ICFG_STR("Port"), int32, range<1024,65535>()),
+    setting(ICFG_STR("Width"), int32, check(ICFG_STR("PositiveWidth"), [](int32_t width){ return width > 0; })),
+    setting(ICFG_STR("Height"), int32)
+  );
+
+  auto result = def.load(jsoncons_loader(write_test_config("ErrorsAreSortedByCode", "{\"Name\":\"abcD\", \"Mode\":\"tiled\", \"Port\":80, \"Width\":-1}")));
+
+  ASSERT_EQ(5u, result.getErrors().size());
+  std::map<error_code, std::size_t> counts;
+  for (const auto& error : result.getErrors()){
+    ++counts[error.code()];
+  }
+  EXPECT_EQ(1u, counts[error_code::missing_setting]);
+  EXPECT_EQ(1u, counts[error_code::pattern_constraint]);
+  EXPECT_EQ(1u, counts[error_code::choice_constraint]);
+  EXPECT_EQ(1u, counts[error_code::range_constraint]);
+  EXPECT_EQ(1u, counts[error_code::check_constraint]);
+
+  //messages are only formatted when asked for
+  for (const auto& error : result.getErrors()){
+    switch (error.code()){
+      case error_code::missing_setting:
+        EXPECT_EQ("The required setting Height wasn't found in the configuration", error.what());
+        break;
+      case error_code::pattern_constraint:
+        EXPECT_EQ("Pattern constraint failed : value must match \"[a-z]+\", actual is \"abcD\"", error.what());
+        break;
+      case error_code::choice_constraint:
+        EXPECT_EQ("Choice constraint failed : value must be one of \"windowed\", \"fullscreen\", actual is \"tiled\"", error.what());
+        break;
+      case error_code::range_constraint:
+        EXPECT_EQ("Range constraint failed : value must be between 1024 and 65535, actual is 80", error.what());
+        break;
+      case error_code::check_constraint:
+        EXPECT_EQ("Constraint validation \"PositiveWidth\" failed.", error.what());
+        break;
+      default:
+        ADD_FAILURE() << error.what();
+    }
+  }
+
+  EXPECT_EQ(error_code::custom, ConfigError("custom message").code());
+  EXPECT_EQ("custom message", ConfigError("custom message").what());
+  
+  //text, path and location lie out of line : a copy owns its own
+  ConfigError original(error_code::choice_constraint);
+  original.with(std::string("tiled")).with(std::string("fullscreen"));
+  original.prefixPath("Mode");
+  ConfigError copy(original);
+  original.prefixPath("Window");
+  EXPECT_EQ("Mode", copy.getPath());
+  EXPECT_EQ("Window.Mode", original.getPath());
+  EXPECT_EQ(original.what(), copy.what());
+  EXPECT_EQ("", ConfigError(error_code::missing_setting).getPath());
+  EXPECT_GE(96u, sizeof(ConfigError));
+}
+
+/**
+Background validation
+*/
+
+TEST(RuntimeTest, BackgroundValidationReportsConstraintsLater){
+  auto def = 
+  config(
+    setting(ICFG_STR("Name"), string, length>3),
+    section(ICFG_STR("Window"),
+      setting(ICFG_STR("Width"), int32, check(ICFG_STR("PositiveWidth"), [](int32_t width){ return width > 0; }))
+    ),
+    map(ICFG_STR("Players"),
+      setting(ICFG_STR("Score"), uint32, check(ICFG_STR("ScoreBelowHundred"), [](uint32_t score){ return score < 100; }))
+    ),
+    switchOn(ICFG_STR("Type"),
+      caseOf(ICFG_STR("Mouse"),
+        setting(ICFG_STR("Sensitivity"), float32, check(ICFG_STR("Sensible"), [](float sensitivity){ return sensitivity <= 1.f; }))
+      ),
+      caseOf(ICFG_STR("Keyboard"),
+        setting(ICFG_STR("Jump"), string)
+      )
+    )
+  );
+  
+  std::string fileName = write_test_config("BackgroundValidationReportsConstraintsLater", "{\"Name\":\"abc\",\"Window\":{\"Width\":-1},\"Players\":{\"bob\":{\"Score\":3},\"alice\":{\"Score\":700}},\"Type\":\"Mouse\",\"Sensitivity\":2.5}");
+  
+  //inline, every constraint fails the load
+  auto inlineResult = def.load(jsoncons_loader(fileName));
+  ASSERT_EQ(4u, inlineResult.getErrors().size());
+  
+  std::vector<std::function<void()>> pending;
+  auto early = def.load(jsoncons_loader(fileName), validate_in_background([&pending](std::function<void()> task){ pending.push_back(task); }));
+  
+  //the values are usable before the constraints are checked
+  ASSERT_FALSE(early.result().hasError());
+  EXPECT_EQ(-1, early.result().get(ICFG_STR("Window")).get(ICFG_STR("Width")));
+  EXPECT_EQ(700u, early.result().get(ICFG_STR("Players")).at("alice").get(ICFG_STR("Score")));
+  
+  ASSERT_EQ(1u, pending.size());
+  std::thread validator(pending.front());
+  const std::vector<ConfigError>& errors = early.validation().get();
+  validator.join();
+  ASSERT_EQ(4u, errors.size());
+  EXPECT_EQ("Name", errors[0].getFailingSettingName());
+  EXPECT_EQ("Width", errors[1].getFailingSettingName());
+  EXPECT_EQ("Score", errors[2].getFailingSettingName());
+  EXPECT_EQ("Sensitivity", errors[3].getFailingSettingName());
+  //located once the loader is gone
+  EXPECT_EQ(fileName, errors[1].getFile());
+  EXPECT_EQ(1u, errors[1].getLine());
+  
+#ifdef ICFG_TEST_JSONCPP
+  pending.clear();
+  auto earlyJsoncpp = def.load(jsoncppLoader(fileName), validate_in_background([&pending](std::function<void()> task){ pending.push_back(task); }));
+  ASSERT_EQ(1u, pending.size());
+  pending.front()();
+  ASSERT_EQ(4u, earlyJsoncpp.validation().get().size());
+  EXPECT_EQ(fileName, earlyJsoncpp.validation().get()[1].getFile());
+  EXPECT_EQ(1u, earlyJsoncpp.validation().get()[1].getLine());
+#endif
+  
+  //a setting missing from the file is reported by the binding only, its constraints are never checked
+  std::string missingFileName = write_test_config("BackgroundValidationReportsConstraintsLater", "{\"Window\":{\"Width\":-1},\"Players\":{},\"Type\":\"Keyboard\",\"Jump\":\"space\"}");
+  pending.clear();
+  auto earlyMissing = def.load(jsoncons_loader(missingFileName), validate_in_background([&pending](std::function<void()> task){ pending.push_back(task); }));
+  ASSERT_EQ(1u, earlyMissing.result().getErrors().size());
+  EXPECT_EQ(error_code::missing_setting, earlyMissing.result().getErrors()[0].code());
+  ASSERT_EQ(1u, pending.size());
+  pending.front()();
+  ASSERT_EQ(1u, earlyMissing.validation().get().size());
+  EXPECT_EQ("Width", earlyMissing.validation().get()[0].getFailingSettingName());
+  
+  EXPECT_EQ(2u, def.load(jsoncons_loader(missingFileName), load_options().validation_threads(2)).getErrors().size());
+}
+
+TEST(RuntimeTest, ParallelValidationKeepsTheErrorOrder){
+  auto def = 
+  config(
+    map(ICFG_STR("Players"),
+      setting(ICFG_STR("Name"), string, length>2),
+      setting(ICFG_STR("Score"), uint32, check(ICFG_STR("ScoreBelowHundred"), [](uint32_t score){ return score < 100; }))
+    ),
+    setting(ICFG_STR("Season"), uint32, range(1, 10))
+  );
+  
+  //constraint failures mixed with missing settings, the binding errors
+  std::string content = "{\"Players\":{";
+  for (int i = 0; i < 2000; ++i){
+    content += (i == 0 ? "\"p" : ",\"p") + std::to_string(i) + "\":{\"Name\":\"" + (i % 7 == 0 ? "x" : "player") + "\"";
+    if (i % 11 != 0){
+      content += ",\"Score\":" + std::to_string(i % 150);
+    }
+    content += "}";
+  }
+  content += "},\"Season\":12}";
+  jsoncons_loader loader(write_test_config("ParallelValidationKeepsTheErrorOrder", content));
+  
+  auto serial = def.load(loader);
+  auto parallel = def.load(loader, load_options().validation_threads(4));
+  auto parallelAgain = def.load(loader, load_options().validation_threads(3));
+  
+  ASSERT_FALSE(serial.getErrors().empty());
+  EXPECT_EQ(error_code::missing_setting, serial.getErrors()[1].code());
+  for (auto* other : {&parallel, &parallelAgain}){
+    ASSERT_EQ(serial.getErrors().size(), other->getErrors().size());
+    for (std::size_t i = 0; i < serial.getErrors().size(); ++i){
+      EXPECT_EQ(serial.getErrors()[i].what(), other->getErrors()[i].what());
+      EXPECT_EQ(serial.getErrors()[i].getPath(), other->getErrors()[i].getPath());
+      EXPECT_EQ(serial.getErrors()[i].getFailingSettingName(), other->getErrors()[i].getFailingSettingName());
+    }
+  }
+  
+  //the cap applies to the errors in that order
+  auto capped = def.load(loader, load_options().validation_threads(4).max_errors(5));
+  ASSERT_EQ(5u, capped.getErrors().size());
+  for (std::size_t i = 0; i < 5; ++i){
+    EXPECT_EQ(serial.getErrors()[i].what(), capped.getErrors()[i].what());
+  }
+}
+
+/**
+Asynchronous load
+*/
+
+TEST(RuntimeTest, AsyncLoadRunsOnTheExecutor){
+  auto def = 
+  config(
+    setting(ICFG_STR("Port"), uint16)
+  );
+  
+  std::string fileName = write_test_config("AsyncLoadRunsOnTheExecutor", "{\"Port\":8080}");
+  std::vector<std::thread> workers;
+  auto executor = [&workers](std::function<void()> task){ workers.push_back(std::thread(task)); };
+  
+  auto future = def.load_async([fileName]{ return jsoncons_loader(fileName); }, executor);
+  auto result = future.get();
+  ASSERT_FALSE(result.hasError());
+  EXPECT_EQ(8080, result.get(ICFG_STR("Port")));
+  
+  //loader errors are delivered through the future
+  auto failed = def.load_async([]{ return jsoncons_loader("AsyncLoadRunsOnTheExecutor_missing.json"); }, executor);
+  EXPECT_THROW(failed.get(), std::string);
+  
+  //the completion handler runs on the caller's executor
+  std::vector<std::function<void()>> callerQueue;
+  std::mutex callerMutex;
+  auto callerExecutor = [&](std::function<void()> task){ std::lock_guard<std::mutex> lock(callerMutex); callerQueue.push_back(task); };
+  uint16_t port = 0;
+  def.load_async([fileName]{ return jsoncons_loader(fileName); }, executor, callerExecutor, [&port](std::future<decltype(def)::result_type> loaded){
+    port = loaded.get().get(ICFG_STR("Port"));
+  });
+  
+  for (std::size_t i = 0; i < workers.size(); ++i){
+    workers[i].join();
+  }
+  EXPECT_EQ(0, port);
+  ASSERT_EQ(1u, callerQueue.size());
+  callerQueue.front()();
+  EXPECT_EQ(8080, port);
+}
@@ -0,0 +1,17 @@
+#include "instantConfig.h"
+
+using namespace icfg;
+
+auto settingString = 
+config(
+  setting(
+    ICFG_STR("mySetting"),
+    icfg::string,
+    range<0,10>()
+  )
+);
+
+int main(){
+
+  return 0;
+}
\ No newline at end of file
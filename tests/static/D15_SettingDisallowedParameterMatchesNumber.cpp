@@ -0,0 +1,17 @@
+#include "instantConfig.h"
+
+using namespace icfg;
+
+auto settingString = 
+config(
+  setting(
+    ICFG_STR("mySetting"),
+    icfg::int32,
+    matches("[0-9]+")
+  )
+);
+
+int main(){
+
+  return 0;
+}
\ No newline at end of file
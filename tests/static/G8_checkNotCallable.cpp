@@ -0,0 +1,19 @@
+#include "instantConfig.h"
+
+using namespace icfg;
+
+struct NotCallable{
+};
+
+auto settingString = 
+config(
+  setting(
+    ICFG_STR("setting"), string
+  ),
+  check(ICFG_STR("constraint"), NotCallable())
+);
+
+int main(){
+
+  return 0;
+}